@@ -5,180 +5,59 @@
 #include <iostream>
 #include <map>
 #include "indSimplexTree.hpp"
+#include "simplexCollapse.hpp"
+#include "simplexCoreduction.hpp"
+#include "lowerStar.hpp"
 
 
-indSimplexTree::indSimplexTree(double _maxEpsilon, std::vector<std::vector<double>> _distMatrix, int _maxDim){
+indSimplexTree::indSimplexTree(double _maxEpsilon, condensedDistMatrix&& _distMatrix, int _maxDim){
 	indexCounter = 0;
-	distMatrix = _distMatrix;
+	distMatrix = std::move(_distMatrix);
 	maxDim = _maxDim;
 	maxEpsilon = _maxEpsilon;
 	simplexType = "indSimplexTree";
 	return;
 }
 
-std::pair<std::vector<std::set<unsigned>>,std::vector<std::set<unsigned>>> indSimplexTree::recurseReduce(std::set<unsigned> sourceSet, int fc, std::set<unsigned> curNode,int d, std::vector<std::set<unsigned>> removalSimplices, std::vector<std::set<unsigned>> processedSimplices){
-	processedSimplices.push_back(curNode);
-	
-	std::vector<std::set<unsigned>> localBuf;
-	std::vector<std::set<unsigned>> localFaces;
-	
-	//Get simplex subsets to track common faces - these are candidate subsets before evaluation
-	auto subsets = ut.getSubsets(curNode, d);
-	
-	//For each candidate subset prior to evaluation
-	for(auto subset : subsets){
-		for(int z = 0; z < dimensions[d].size(); z++){
-			
-			//Check if the simplex has already been processed
-			if(std::find(removalSimplices.begin(), removalSimplices.end(), dimensions[d][z]->simplexSet) == removalSimplices.end() && \
-				std::find(processedSimplices.begin(), processedSimplices.end(), dimensions[d][z]->simplexSet) == processedSimplices.end()){
-			//if(dimensions[d][z]->simplexSet != curNode){
-				
-				
-				//If there is an intersection with the current simplex
-				if(ut.setIntersect(dimensions[d][z]->simplexSet,subset,true).size() == dimensions[d][z]->simplexSet.size() - 1	){
-					localBuf.push_back(subset);
-					localFaces.push_back(dimensions[d][z]->simplexSet);
-					//Add the current simplex to graph removal
-					//removalSimplices.push_back(dimensions[d][z]->simplexSet);
-					//std::cout << "Removal: ";
-					//ut.print1DVector(dimensions[d][z]->simplexSet);
-					//deletion(dimensions[d][z]->simplexSet);
-									
-					
-					//Find the additional simplices to remove from the graph					
-					//if(std::find(removalSimplices.begin(), removalSimplices.end(), curNode) == removalSimplices.end()){
-					//	removalSimplices.push_back(curNode);
-					//}
-					break;
-				}
-			}
-		}
+// Coreduce the sorted graph (see simplexCoreduction.hpp) into the graph returned by
+//		getIndexEdges; the tree and getAllEdges keep every simplex
+void indSimplexTree::coreduction(){
+	if(!isSorted){
+		sortAndBuildGraph();
+		isSorted = true;
 	}
-	//std::cout << "Local Buf: " << localBuf.size() << "\tSubsets: " << subsets.size() << std::endl;
 	
-	//Recurses to determine if the neighboring faces all have connected faces
-	if(localBuf.size() == subsets.size()){
-		bool recurse = false;
-		for(auto face : localFaces){
-			
-			auto a = recurseReduce(curNode, 0, face, d, removalSimplices, processedSimplices);
-			processedSimplices = a.first;
-			if(a.second.size() > removalSimplices.size())
-				recurse = true;
-			removalSimplices = a.second;
-			
-		}
-		
-		if(recurse){
-			//Refresh the local buffer for faces that match
-			auto a = recurseReduce(sourceSet, 0, curNode, d, removalSimplices, processedSimplices);
-		}
-		
-		
-	} else if(dimensions[d].size() == 1 || localBuf.size() != subsets.size()){		
-		
-		std::set<unsigned> non_min;
-		double minVal = -1;
-		
-		//For each subset
-		for(auto z : subsets){
-			//if the subset is not in the local buffer (i.e. did not get filtered by faces)
-			if(std::find(localBuf.begin(), localBuf.end(), z) == localBuf.end()){
-				//std::cout << "Candidate: ";
-				//ut.print1DVector(z);
-				double d = getWeight(z);
-				if(minVal < 0){
-					minVal = d;
-					non_min = z;
-				} else if(d > minVal){
-					non_min = z;
-				} else {
-					minVal = d;
-				}
-				//std::cout << "\tWT: " << d << std::endl;
-			}
-		}		
-		if(non_min.size() > 0){
-			removalSimplices.push_back(non_min);
-			removalSimplices.push_back(curNode);
-			std::cout << "Removal: ";
-			ut.print1DVector(non_min);
-			//std::cout << "  ,  ";
-			ut.print1DVector(curNode);
-			//auto a = recurseReduce(curNode, 0, non_min, d-1, removalSimplices, processedSimplices);
-			//processedSimplices = a.first;
-			//removalSimplices = a.second;
-		}
-		fc = 0;
+	std::vector<std::vector<std::pair<smallSimplex, double>>> chains(indexedGraph.size());
+	for(unsigned d = 0; d < indexedGraph.size(); d++){
+		chains[d].reserve(indexedGraph[d].size());
+		for(auto& entry : indexedGraph[d])
+			chains[d].push_back(std::make_pair(entry.simplexSet, entry.weight));
 	}
 	
-	return std::make_pair(processedSimplices, removalSimplices);
-}
-
-std::vector<std::vector<simplexBase::graphEntry>> indSimplexTree::coreduction(graphEntry cur){
-	std::vector<std::vector<graphEntry>> ret = indexedGraph;
-	//Queue q ; q.insert (cur)
-	std::vector<graphEntry> simplexQueue;
-	
-	simplexQueue.push_back(cur);
-		
-	//While (queue.next() != end)
-	while(simplexQueue.size() > 0){
-		
-			//std::cout << "cored" << std::endl;
-		// s = q.pop();
-		graphEntry currentEntry = simplexQueue[0];
-		
-		//Compute cbds, bds
-		//	cbds(a) = {s <= S | k(s,t) != 0 for some t <= a}
-		std::vector<graphEntry> cbds;
-		
-		//	bds(a) = {t <= S | k(s, t) != 0 for some s <= a}
-		std::vector<graphEntry> bds;
-		
-		
-			//std::cout << "cored " << simplexQueue.size() << std::endl;
-		//if bds.size = 1
-		if(bds.size() == 1){
-		
-			//remove s from indexedGraph
-			
-			
-			//foreach coboundary of t
-			for(auto ge : cbds){
-				//queue.insert(u)
-				simplexQueue.push_back(ge);
-			}
-			
-			//remove t from s
-			
-		}
-		
-		
-		//if bds s = null 
-		if(bds.size() == 0){
-			
-			//for each coboundary of s
-			for(auto ge : cbds){
-				//queue.insert(u)
-				simplexQueue.push_back(ge);
+	auto removed = coreduceComplex(chains);
+	chains.clear();
+	
+	//Remaining simplices keep their order; findIndex returns positions in the coreduced graph
+	coreducedGraph.assign(indexedGraph.size(), std::vector<graphEntry>());
+	for(unsigned d = 0; d < indexedGraph.size(); d++){
+		for(unsigned i = 0; i < indexedGraph[d].size(); i++){
+			graphEntry& entry = indexedGraph[d][i];
+			if(removed[d][i]){
+				entry.entry->sortedIndex = noSimplex;
+			} else {
+				entry.entry->sortedIndex = coreducedGraph[d].size();
+				coreducedGraph[d].push_back(entry);
 			}
 		}
-		
-		simplexQueue.erase(simplexQueue.begin());
-		//std::cout << "cored " << simplexQueue.size() << std::endl;
 	}
-	//std::cout << "RET" << std::endl;
-	return ret;
 }
 
-void indSimplexTree::recurseInsert(indTreeNode* node, unsigned curIndex, int depth, double maxE, std::set<unsigned> simp){
+void indSimplexTree::recurseInsert(indTreeNode* node, unsigned curIndex, int depth, double maxE, smallSimplex simp){
 	//Incremental insertion
 	//Recurse to each child (which we'll use the parent pointer for...)
 	indTreeNode* temp;
 	
-	double curE = distMatrix[node->index][indexCounter];
+	double curE = distance(node->index, indexCounter);
 	curE = curE > maxE ? curE : maxE;
 	
 	depth = simp.size() - 1;
@@ -189,9 +68,11 @@ void indSimplexTree::recurseInsert(indTreeNode* node, unsigned curIndex, int dep
 		indTreeNode* insNode = new indTreeNode();
 		insNode->index = curIndex;
 		nodeCount++;
-		std::set<unsigned> newSimp = simp;
+		smallSimplex newSimp = simp;
 		newSimp.insert(node->index);
 		insNode->simplexSet = newSimp;
+		if(dimCounts.size() < (unsigned)depth + 2)
+			dimCounts.resize(depth + 2, 0);
 		dimCounts[depth+1]++;
 		
 		//Get the largest weight of this simplex
@@ -274,7 +155,7 @@ void indSimplexTree::insertInductive(){
 			//Determine if the index needs to inserted below the current node
 			//	First, check the distance matrix for curNodeIndex v. curIndex
 			//	Second (if first is true), check all parents dist matrix of parentNodeIndex v. curIndex
-			if(distMatrix[curNode->index][indexCounter] < maxEpsilon){
+			if(distance(curNode->index, indexCounter) < maxEpsilon){
 				//	This node is a candidate, now we need to check each parent of the current branch
 				//		to ensure the distance matrix entry for parentNodeindex v. curIndex is < maxEpsilon
 
@@ -283,7 +164,7 @@ void indSimplexTree::insertInductive(){
 			
 				// This loop will check each parent and set whether to insert a node
 				do{
-					if(distMatrix[parentNode->index][indexCounter] > maxEpsilon){
+					if(distance(parentNode->index, indexCounter) > maxEpsilon){
 						ins = false;
 					}	
 				}while(ins && parentNode->parent != nullptr && (parentNode = parentNode->parent) != nullptr);
@@ -348,7 +229,7 @@ void indSimplexTree::insertInductive(){
 //		
 void indSimplexTree::insert(std::vector<double>&) {
 	
-	if(distMatrix.size() == 0){
+	if(!hasDistances()){
 		ut.writeDebug("simplexTree","Distance matrix is empty, skipping insertion");
 		return;
 	}
@@ -357,7 +238,7 @@ void indSimplexTree::insert(std::vector<double>&) {
 	indTreeNode* curNode = new indTreeNode;
 	curNode->index = indexCounter;
 	
-	std::set<unsigned> tempSet = {curNode->index};
+	smallSimplex tempSet = {curNode->index};
 	
 	//Check if this is the first node (i.e. head)
 	//	If so, initialize the head node
@@ -412,14 +293,22 @@ void indSimplexTree::insert(std::vector<double>&) {
 	
 	
 	
-	do{
-		recurseInsert(temp, indexCounter, 0, 0, tempSet);
-	}while(temp->sibling != nullptr && (temp = temp->sibling) != nullptr);
-	
-	//Insert into the right of the tree
-	temp = dimensions[0][0];
+	if(!neighborGraph.empty() && indexCounter < neighborGraph.size() && dimensions[0].size() == indexCounter){
+		//Sparse graph: only the stored (earlier) neighbors of the new point can share a simplex
+		//	with it; rows are sorted, so the vertices are visited in the same order
+		for(auto it = neighborGraph.neighborsBegin(indexCounter); it != neighborGraph.neighborsEnd(indexCounter) && *it < indexCounter; it++)
+			recurseInsert(dimensions[0][*it], indexCounter, 0, 0, tempSet);
+		temp = dimensions[0].back();
+	} else {
+		do{
+			recurseInsert(temp, indexCounter, 0, 0, tempSet);
+		}while(temp->sibling != nullptr && (temp = temp->sibling) != nullptr);
+		
+		//Insert into the right of the tree
+		temp = dimensions[0][0];
+		while(temp->sibling != nullptr && (temp = temp->sibling) != nullptr);
+	}
 	indTreeNode* ins = new indTreeNode();
-	while(temp->sibling != nullptr && (temp = temp->sibling) != nullptr);
 	ins->index = indexCounter;
 	ins->sibling = nullptr;
 	ins->parent = nullptr;
@@ -438,9 +327,83 @@ void indSimplexTree::insert(std::vector<double>&) {
 }
 
 
+// Insert every point (neighGraph); with threads > 1 on an empty tree the lower stars of the
+//		points are enumerated in parallel (see lowerStar.hpp) and linked here in point order
+void indSimplexTree::insertAll(std::vector<std::vector<double>>& points){
+	unsigned n = std::count_if(points.begin(), points.end(), [](const std::vector<double>& point){ return !point.empty(); });
+	
+	if(threads <= 1 || head != nullptr || !hasDistances()){
+		simplexBase::insertAll(points);
+		return;
+	}
+	
+	auto stars = lowerStars(*this, n, maxDim, threads);
+	
+	//Node of each depth on the current entry's path, and the last child matched below the
+	//		node of the depth above (entries under one node come largest vertex first)
+	std::vector<indTreeNode*> pathNodes, matched;
+	
+	for(unsigned k = 0; k < n; k++){
+		for(auto& entry : stars[k]){
+			indTreeNode* node;
+			if(entry.depth == 0){
+				node = dimensions[0][entry.vertex];
+			} else {
+				node = matched[entry.depth] == nullptr ? pathNodes[entry.depth - 1]->child : matched[entry.depth];
+				while(node->index != entry.vertex)
+					node = node->sibling;
+				matched[entry.depth] = node;
+			}
+			pathNodes.resize(entry.depth + 1);
+			pathNodes[entry.depth] = node;
+			matched.resize(entry.depth + 2, nullptr);
+			matched[entry.depth + 1] = nullptr;
+			
+			//Link the new node at the front of the children, as recurseInsert does
+			indTreeNode* insNode = new indTreeNode();
+			insNode->index = k;
+			insNode->simplexSet = node->simplexSet;
+			insNode->simplexSet.insert(k);
+			insNode->weight = entry.weight;
+			insNode->parent = node;
+			insNode->sibling = node->child;
+			node->child = insNode;
+			nodeCount++;
+			
+			if(dimCounts.size() < entry.depth + 2)
+				dimCounts.resize(entry.depth + 2, 0);
+			dimCounts[entry.depth + 1]++;
+			
+			if(dimensions.size() < entry.depth + 2)
+				dimensions.emplace_back();
+			dimensions[entry.depth + 1].push_back(insNode);
+		}
+		
+		//Append the vertex to the right of the tree
+		indTreeNode* ins = new indTreeNode();
+		ins->index = k;
+		ins->sortedIndex = k;
+		ins->simplexSet = { k };
+		if(head == nullptr){
+			head = ins;
+			dimensions.emplace_back();
+		} else {
+			dimensions[0].back()->sibling = ins;
+		}
+		
+		dimensions[0].push_back(ins);
+		dimCounts[0]++;
+		nodeCount++;
+		indexCounter++;
+	}
+	
+	return;
+}
+
+
 // Iterative function to search for a key in the tree. The function returns true
 // if the key is found, else it returns false.
-bool indSimplexTree::search(std::set<unsigned> simplex){
+bool indSimplexTree::search(smallSimplex simplex){
 	indTreeNode* curNode = dimensions[0][0];
 	
 	for(auto i :simplex){
@@ -452,17 +415,15 @@ bool indSimplexTree::search(std::set<unsigned> simplex){
 }
 
 
-double indSimplexTree::getWeight(std::set<unsigned> search){
+double indSimplexTree::getWeight(smallSimplex search){
 	indTreeNode* curNode = dimensions[0][0];
 	
 	//std::cout << "Get Weight - Size: " << search.size() << "\tSimplex Count: " << dimensions[search.size()-1].size() << "\t";
 	//ut.print1DVector(search);
 	
-	for(auto a : dimensions[search.size()-1]){
-		if(search == a->simplexSet){
-			return a->weight;
-		}
-	}
+	unsigned i = nodePosition(search);
+	if(i != noSimplex)
+		return dimensions[search.size()-1][i]->weight;
 	return 10000;
 	
 	/*	
@@ -490,19 +451,19 @@ bool indSimplexTree::haveChild(indSimplexTree const* present) {
 
 
 // A recursive function to delete a simplex (and sub-branches) from the tree.
-bool indSimplexTree::deletion(std::set<unsigned> removalEntry) {
+bool indSimplexTree::deletion(smallSimplex removalEntry) {
 	//Remove the entry in the simplex tree
 	bool found = true;
 	indTreeNode* curNode = dimensions[0][0];
 	int d = removalEntry.size() - 1;
 	
 	
-	for(int i = 0; i < dimensions[d].size(); i++){
-		if(removalEntry == dimensions[d][i]->simplexSet){
-			curNode = dimensions[d][i];
-			dimensions[d].erase(dimensions[d].begin() + i);
-			return deletion(curNode);
-		}
+	unsigned i = nodePosition(removalEntry);
+	if(i != noSimplex){
+		curNode = dimensions[d][i];
+		dimensions[d].erase(dimensions[d].begin() + i);
+		clearIndex(d);
+		return deletion(curNode);
 	}
 	return false;
 			
@@ -573,31 +534,69 @@ int indSimplexTree::simplexCount(){
 	return nodeCount;
 } 
 
-bool indSimplexTree::find(std::set<unsigned> simplex){
+// Position of a simplex in dimensions[d], noSimplex if not present
+//		O(1) keyed lookup, falls back to a linear scan when the dimension can't be keyed
+unsigned indSimplexTree::nodePosition(const smallSimplex& simplex){
+	if(simplex.empty() || dimensions.size() < simplex.size())
+		return noSimplex;
+	
+	unsigned d = simplex.size() - 1;
+	unsigned vertices = dimensions[0].size();
+	if(simplexIndex.size() <= d){
+		simplexIndex.resize(d + 1);
+		indexedCount.resize(d + 1, 0);
+	}
+	
+	binomials.reserve(vertices, d + 1);
+	if(binomials.fits(vertices, d + 1)){
+		if(*simplex.rbegin() >= vertices)
+			return noSimplex;
+		
+		//Index any nodes inserted since the last lookup
+		if(indexedCount[d] < dimensions[d].size()){
+			simplexIndex[d].reserve(dimensions[d].size());
+			for(unsigned i = indexedCount[d]; i < dimensions[d].size(); i++)
+				simplexIndex[d].insert(binomials.key(dimensions[d][i]->simplexSet), dimensions[d][i]->weight, i);
+			indexedCount[d] = dimensions[d].size();
+		}
+		return simplexIndex[d].position(binomials.key(simplex));
+	}
+	
+	for(unsigned i = 0; i < dimensions[d].size(); i++){
+		if(dimensions[d][i]->simplexSet == simplex)
+			return i;
+	}
+	return noSimplex;
+}
+
+// Positions in dimensions[d] shifted; rebuild the index on the next lookup
+void indSimplexTree::clearIndex(unsigned d){
+	if(d < simplexIndex.size()){
+		simplexIndex[d].clear();
+		indexedCount[d] = 0;
+	}
+}
+
+bool indSimplexTree::find(smallSimplex simplex){
 	if(dimensions.size() == 0){
 		ut.writeDebug("indSimplexTree","Complex is empty, skipping find");
 		return false;
 	}
-		
-	indTreeNode* curNode = dimensions[0][*simplex.begin()];
 	
-	for(auto i = simplex.begin() ; i != simplex.end(); i++){
-		if(i != simplex.begin() && curNode->child != nullptr){
-			curNode = curNode->child;
-			
-			while(curNode != nullptr){
-				if(curNode->index != *i){
-					curNode = curNode->sibling; 
-				} else if(curNode->index == *i){
-					break;
-				} else { 
-					return -1; 
-				}
-			}
-		}
+	return nodePosition(simplex) != noSimplex;
+}
+
+// Position of the simplex in the weight sorted graph (getIndexEdges), noSimplex if not present
+unsigned indSimplexTree::findIndex(smallSimplex simplex){
+	if(!isSorted){
+		sortAndBuildGraph();
+		isSorted = true;
 	}
-	return curNode->sortedIndex;	
 	
+	unsigned i = nodePosition(simplex);
+	if(i == noSimplex)
+		return noSimplex;
+	return dimensions[simplex.size() - 1][i]->sortedIndex;
 }
 
 double indSimplexTree::getSize(){
@@ -612,6 +611,7 @@ bool indSimplexTree::compareByWeight(const graphEntry &a, const graphEntry &b){
 void indSimplexTree::sortAndBuildGraph(){
 	
 	std::cout << "========================    SORTING    ===============================" << std::endl;
+	coreducedGraph.clear();
 	indTreeNode* curNode = dimensions[0][0];
 	std::vector<graphEntry> curEntry;
 	std::vector<std::vector<graphEntry>> ret;
@@ -620,6 +620,7 @@ void indSimplexTree::sortAndBuildGraph(){
 	int i = 0;
 	for(auto cur : dimensions[0]){
 		graphEntry ge(cur->simplexSet, cur->weight, cur);
+		cur->sortedIndex = i;
 		curEntry.push_back(ge);
 		//ut.print1DVector(cur->simplexSet);
 		i++;
@@ -667,11 +668,11 @@ void indSimplexTree::sortAndBuildGraph(){
 }
 
 
-std::vector<std::vector<std::pair<std::set<unsigned>,double>>> indSimplexTree::getAllEdges(double epsilon){
+std::vector<std::vector<std::pair<smallSimplex, double>>> indSimplexTree::getAllEdges(double epsilon){
 	
 	
 	
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> ret;
+	std::vector<std::vector<std::pair<smallSimplex, double>>> ret;
 	
 	if(dimensions.size() == 0){
 		ut.writeDebug("indSimplexTree","Complex is empty, no edges to return");
@@ -684,7 +685,7 @@ std::vector<std::vector<std::pair<std::set<unsigned>,double>>> indSimplexTree::g
 	}
 	
 	for(std::vector<graphEntry> a : indexedGraph){
-		std::vector<std::pair<std::set<unsigned>,double>> tempEdges;
+		std::vector<std::pair<smallSimplex, double>> tempEdges;
 		for(auto b : a){
 			tempEdges.push_back(std::make_pair(b.simplexSet, b.weight));
 		}
@@ -710,129 +711,75 @@ std::vector<std::vector<indSimplexTree::graphEntry>> indSimplexTree::getIndexEdg
 		sortAndBuildGraph();
 		isSorted = true;
 	}
-	return indexedGraph;
+	return coreducedGraph.empty() ? indexedGraph : coreducedGraph;
 }
 
+// Filtration preserving elementary collapses (see simplexCollapse.hpp), then coreductions
 void indSimplexTree::reduceComplex(){
-	std::vector<graphEntry> curEntry;
-	graphEntry ge;
 	
-	std::cout << "Reducing simplex tree elementary collapse" << std::endl;
-	std::cout << "\tOriginal simplex count: " << nodeCount << std::endl;
+	ut.writeDebug("indSimplexTree","Reducing complex, starting simplex count: " + std::to_string(nodeCount));
 	
-	if(maxDim < 2){
-		std::cout << "Dim < 2, exiting reduction" << std::endl;
+	if(maxDim < 2 || dimensions.size() < 3){
+		ut.writeDebug("indSimplexTree","Dim < 2, skipping reduction");
 		return;
 	}
 	
+	std::vector<std::vector<std::pair<smallSimplex, double>>> chains(dimensions.size());
+	for(unsigned d = 0; d < dimensions.size(); d++){
+		chains[d].reserve(dimensions[d].size());
+		for(auto node : dimensions[d])
+			chains[d].push_back(std::make_pair(node->simplexSet, node->weight));
+	}
 	
-	//Start at the highest dimension and check for cofaces of simplices
-	//		if there isn't a shared face with another simplex of the
-	//		same dimension then remove the face
-	//
-	//
-	//	There are 4 cases that can happen as we iterate a simplex s_d:
-	//
-	//		1. All faces are shared, s_d >= max_d
-	//		2. All faces are shared, s_d < max_d
-	//		3. Some faces are shared
-	//		4. No faces shared
-	//
-	//
-	//	To do this, we recurse through shared faces and examine neighbor simplices;
-	//
-	//		If a neighbor simplex has all shared faces (and recurses/faces the same), no removal simplices
-	//			will be added. This will be case 1 / 2
-	//
-	//		If a neighbor simplex does not have shared faces, remove the largest edge and the simplex 
-	//			itself. Continue iterating other faces of original simplex. This will be case 3.
-	//
-	//		After all faces are finished, if processed simplices.size() = 1, case 4.
-	//
-	
-	//Iterate each dimension of simplices
-	for(int d = dimensions.size()-1; d > 1 ; d--){
-		std::vector<graphEntry> curGraph;
-		std::map<std::set<unsigned>,int> counts;
-		std::vector<std::set<unsigned>> removalSimplices;
-		std::vector<std::set<unsigned>> processedSimplices;
-		
-		
-		//Iterate each node in the simplex list, dimension d
-		for(auto curNode : dimensions[d]){	
-			
-			//Check if the current node has been processed already
-			if(std::find(processedSimplices.begin(), processedSimplices.end(), curNode->simplexSet) == processedSimplices.end()){
-				
-				//If the current node hasn't been processed, recursively iterate through shared faces and remove simplices
-				//		This function handles case 3 and 4.
-				auto a =  recurseReduce({}, 0, curNode->simplexSet, d, removalSimplices, processedSimplices);
-				
-				//Check for cases 1 / 2
-				if(removalSimplices.size() == a.second.size()){
-					
-					// 1. All faces are shared, s_d >= max_d
-					if(curNode->simplexSet.size() >= maxDim){
-						// Do nothing, need to process through t-array if a feature forms 					
-
-					// 2. All faces are shared, s_d < max_d
-					} else {
-						//Use the minimum path algorithm to remove edges from processed simplices
-						//	Need to remove all non-minimal faces of each processed simplex, along
-						//		with the simplex itself
-					}
-				}
-				
-				processedSimplices = a.first;
-				removalSimplices = a.second;
+	auto removed = collapseComplex(chains);
+	chains.clear();
+	
+	//Removed simplices are closed under cofaces; from the top down each removed node is a leaf
+	for(unsigned d = dimensions.size() - 1; d > 0; d--){
+		unsigned kept = 0;
+		for(unsigned i = 0; i < dimensions[d].size(); i++){
+			indTreeNode* node = dimensions[d][i];
+			if(!removed[d][i]){
+				dimensions[d][kept++] = node;
+				continue;
 			}
-					
-		}
-		
-		//std::cout << "_________Removals_________" << std::endl;
-		//for(auto p: removalSimplices){
-		//	std::cout << "\t";
-		//	ut.print1DVector(p);
-		//}
-		//std::cout << std::endl;
-		
-		//Remove the removals...
-		for(auto r : removalSimplices){
-			for(int i = 0; i < dimensions[d].size(); i++){
-				if(r == dimensions[d][i]->simplexSet){
-					dimensions[d].erase(dimensions[d].begin() + i);
-					nodeCount--;
-				}
+			
+			//Unlink the node from its parent's child list
+			indTreeNode* parent = node->parent;
+			if(parent->child == node){
+				parent->child = node->sibling;
+			} else {
+				indTreeNode* prev = parent->child;
+				while(prev->sibling != node)
+					prev = prev->sibling;
+				prev->sibling = node->sibling;
 			}
-			deletion(r);
+			delete node;
+			nodeCount--;
 		}
-			
+		if(kept == dimensions[d].size())
+			continue;
 		
+		if(d < dimCounts.size())
+			dimCounts[d] -= dimensions[d].size() - kept;
+		dimensions[d].resize(kept);
+		clearIndex(d);
 	}
 	
+	//The sorted graph points at removed nodes; rebuild it on the next lookup
+	indexedGraph.clear();
+	isSorted = false;
 	
-	std::cout << "\tElementary collapse count: " << nodeCount << std::endl;
-	std::cout << "Reducing simplex tree coreduction" << std::endl;
-	
+	ut.writeDebug("indSimplexTree","Elementary collapse count: " + std::to_string(nodeCount));
 	
+	//Coreduction pairs are left out of the graph the persistence stage reduces
+	coreduction();
 	
-	for(auto a : indexedGraph){
-		for(auto b: a){
-			
-			//	Elementary coreduction pair if bds(b) = {a}
-			//
-			//	bds(a) = {t <= S | k(s, t) != 0 for some s <= a}
-			//		where dim(s) = dim(t) + 1
-			//
-			
-			coreduction(b);
-			//std::cout << "Reduced!" << std::endl;
-			
-		}
-	}
+	unsigned remaining = 0;
+	for(auto& entries : coreducedGraph)
+		remaining += entries.size();
+	ut.writeDebug("indSimplexTree","Coreduction count: " + std::to_string(remaining));
 	
-	std::cout << "\tCoreduction count: " << nodeCount << std::endl;
-		
 	return;
 }
 
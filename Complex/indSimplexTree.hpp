@@ -9,7 +9,7 @@ class indSimplexTree : public simplexBase {
 	bool isSorted = false;
 	
 	struct cmp{
-		bool operator()(const std::pair<std::set<unsigned>, double> &a, const std::pair<std::set<unsigned>, double> &b){
+		bool operator()(const std::pair<smallSimplex, double> &a, const std::pair<smallSimplex, double> &b){
 			return (a.second < b.second);
 		}
 	};
@@ -19,38 +19,48 @@ class indSimplexTree : public simplexBase {
 	std::vector<std::vector<indTreeNode*>> dimensions;		
 	
 	unsigned indexCounter;
-	indTreeNode* head;
-	int nodeCount;
+	indTreeNode* head = nullptr;
+	int nodeCount = 0;
+	
+	//Keyed index of dimensions[d] (built lazily, cleared when nodes are erased)
+	std::vector<simplexHash> simplexIndex;
+	std::vector<unsigned> indexedCount;
+	unsigned nodePosition(const smallSimplex&);
+	void clearIndex(unsigned);
+	
+	//Sorted graph without the coreduction pairs (getIndexEdges); empty unless reduceComplex ran
+	std::vector<std::vector<graphEntry>> coreducedGraph;
   
   public:
 	std::vector<std::vector<graphEntry>> indexedGraph;
 	bool isLeaf;
 	
-	indSimplexTree(std::vector<std::vector<double>>);
-	indSimplexTree(double, std::vector<std::vector<double>>, int);
+	indSimplexTree(condensedDistMatrix&&);
+	indSimplexTree(double, condensedDistMatrix&&, int);
 	std::set<unsigned> getFaces(graphEntry ge);
-	std::vector<std::vector<graphEntry>> coreduction(graphEntry);
+	void coreduction();
 	static bool compareByWeight(const graphEntry &, const graphEntry &);
 	void printTree(indTreeNode*);
-	bool search(std::set<unsigned>);
+	bool search(smallSimplex);
 	bool haveChild(indSimplexTree const*);
-	double getWeight(std::set<unsigned>);
+	double getWeight(smallSimplex);
 	void sortAndBuildGraph();
 	void insertInductive();
-	void recurseInsert(indTreeNode*, unsigned, int, double, std::set<unsigned>);
-	std::pair<std::vector<std::set<unsigned>>,std::vector<std::set<unsigned>>> recurseReduce(std::set<unsigned>,int,std::set<unsigned>,int, std::vector<std::set<unsigned>>, std::vector<std::set<unsigned>>);
+	void recurseInsert(indTreeNode*, unsigned, int, double, smallSimplex);
 	
 	//virtual interface functions
 	double getSize();
 	void insert(std::vector<double>&);
-	bool find(std::set<unsigned>);
+	void insertAll(std::vector<std::vector<double>>&);
+	bool find(smallSimplex);
+	unsigned findIndex(smallSimplex);
 	int simplexCount();
 	int vertexCount();
 	std::vector<std::vector<unsigned>> getDimEdges(int,double);
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> getAllEdges(double);
+	std::vector<std::vector<std::pair<smallSimplex, double>>> getAllEdges(double);
 	std::vector<std::vector<graphEntry>> getIndexEdges(double);
 	bool deletion(indTreeNode*);
-	bool deletion(std::set<unsigned>);
+	bool deletion(smallSimplex);
 	void expandDimensions(int){return;};
 	void reduceComplex();
 	
@@ -0,0 +1,108 @@
+#pragma once
+
+#ifndef LOWERSTAR_HPP_INCL
+#define LOWERSTAR_HPP_INCL
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include "simplexBase.hpp"
+
+// Header only parallel insertion for the simplex trees (simplexTree, indSimplexTree)
+//		Inserting point k (recurseInsert) adds the simplices whose largest vertex is k, its
+//		lower star, under the nodes of the earlier points. Which nodes exist, and their
+//		weights, only depend on the distances, so the lower star of every point can be
+//		enumerated independently: the workers claim points and walk each star in the order
+//		recurseInsert visits it, then the tree links the entries in point order and ends up
+//		with the same nodes, weights and edge lists as inserting the points one by one.
+
+// A simplex of a lower star: k goes under the node at depth (0 for a vertex) whose last
+//		vertex is vertex, the node being the previous entry's at depth - 1 otherwise
+struct starEntry {
+	unsigned vertex;
+	unsigned depth;
+	double weight;
+};
+
+// Walk the lower star of k below the node path (vertices, node weights), as recurseInsert does;
+//		lower holds the earlier vertices within maxEpsilon of k in ascending order
+inline void lowerStarVisit(const simplexBase& complex, unsigned k, unsigned maxDim, const std::vector<unsigned>& lower, std::vector<unsigned>& path, std::vector<filtrationValue>& weights, double maxE, std::vector<starEntry>& star){
+	double curE = complex.distance(path.back(), k);
+	curE = curE > maxE ? curE : maxE;
+	if(!(curE < complex.maxEpsilon))
+		return;
+
+	maxE = curE > weights.back() ? curE : weights.back();
+	star.push_back({path.back(), (unsigned)path.size() - 1, maxE});
+
+	if(path.size() + 1 > maxDim)
+		return;
+
+	//Children of the node, largest first (the tree's sibling order): an earlier vertex c
+	//		was linked below it if each prefix of the path passed recurseInsert's test for c
+	for(auto c = lower.rbegin(); c != lower.rend() && *c > path.back(); c++){
+		double chainE = 0;
+		bool linked = true;
+		for(unsigned t = 0; t < path.size() && linked; t++){
+			double e = complex.distance(path[t], *c);
+			e = e > chainE ? e : chainE;
+			if(!(e < complex.maxEpsilon))
+				linked = false;
+			else
+				chainE = e > weights[t] ? e : weights[t];
+		}
+		if(!linked)
+			continue;
+
+		path.push_back(*c);
+		weights.push_back(chainE);
+		lowerStarVisit(complex, k, maxDim, lower, path, weights, maxE, star);
+		path.pop_back();
+		weights.pop_back();
+	}
+}
+
+// Lower stars of points 0..n-1 of the complex's distances (simplices up to maxDim vertices),
+//		split over the threads a point at a time
+inline std::vector<std::vector<starEntry>> lowerStars(const simplexBase& complex, unsigned n, unsigned maxDim, unsigned threads){
+	std::vector<std::vector<starEntry>> stars(n);
+	std::atomic<unsigned> nextPoint(0);
+	const sparseNeighborGraph& graph = complex.neighborGraph;
+
+	auto worker = [&](unsigned){
+		std::vector<unsigned> lower, path;
+		std::vector<filtrationValue> weights;
+
+		for(unsigned k = nextPoint++; k < n; k = nextPoint++){
+			//Sparse graph: only the stored (earlier) neighbors of k can share a simplex with it
+			lower.clear();
+			if(!graph.empty() && k < graph.size()){
+				for(auto it = graph.neighborsBegin(k); it != graph.neighborsEnd(k) && *it < k; it++)
+					if(complex.distance(*it, k) < complex.maxEpsilon)
+						lower.push_back(*it);
+			} else {
+				for(unsigned u = 0; u < k; u++)
+					if(complex.distance(u, k) < complex.maxEpsilon)
+						lower.push_back(u);
+			}
+
+			for(auto u : lower){
+				path.assign(1, u);
+				weights.assign(1, 0);
+				lowerStarVisit(complex, k, maxDim, lower, path, weights, 0, stars[k]);
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for(unsigned t = 1; t < std::min(threads, n); t++)
+		workers.push_back(std::thread(worker, t));
+	worker(0);
+	for(auto &w : workers)
+		w.join();
+
+	return stars;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#ifndef NODEARENA_HPP_INCL
+#define NODEARENA_HPP_INCL
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstddef>
+
+// Header only slab allocator for the fixed size nodes of the tree complexes
+//		Nodes are addressed by 32-bit index and bump-allocated from fixed slabs, so
+//		they never move and cost no heap allocation each. Released nodes are
+//		recycled through a free list; reset() empties the arena in O(1) and keeps
+//		the slabs for the next build.
+
+// Index of "no node" (replaces nullptr links)
+const unsigned nullNode = std::numeric_limits<unsigned>::max();
+
+template<typename T, unsigned slabBits = 16>
+class nodeArena {
+  private:
+	std::vector<std::unique_ptr<T[]>> slabs;
+	std::vector<unsigned> freeList;
+	unsigned top = 0;
+	unsigned live = 0;
+
+  public:
+	T& operator[](unsigned i){ return slabs[i >> slabBits][i & ((1u << slabBits) - 1)]; };
+	const T& operator[](unsigned i) const { return slabs[i >> slabBits][i & ((1u << slabBits) - 1)]; };
+
+	// Allocate a default initialized node, returns its index
+	unsigned allocate(){
+		unsigned i;
+		if(!freeList.empty()){
+			i = freeList.back();
+			freeList.pop_back();
+		} else {
+			if((top >> slabBits) == slabs.size())
+				slabs.emplace_back(new T[1u << slabBits]);
+			i = top++;
+		}
+
+		(*this)[i] = T();
+		live++;
+		return i;
+	};
+
+	// Return a node to the free list
+	void release(unsigned i){
+		freeList.push_back(i);
+		live--;
+	};
+
+	// Drop every node, the slabs are kept for reuse
+	void reset(){
+		top = 0;
+		live = 0;
+		freeList.clear();
+	};
+
+	unsigned size() const { return live; };
+
+	// Memory held by the slabs (bytes)
+	size_t reserved() const { return slabs.size() * ((size_t)1 << slabBits) * sizeof(T); };
+};
+
+#endif
@@ -1,14 +1,19 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <atomic>
 #include "simplexArrayList.hpp"
+#include "simplexCollapse.hpp"
 
 // simplexArrayList constructor, currently no needed information for the class constructor
-simplexArrayList::simplexArrayList(double maxE, double maxD, std::vector<std::vector<double>> _distMatrix){
+simplexArrayList::simplexArrayList(double maxE, double maxD, condensedDistMatrix&& _distMatrix){
 	simplexType = "simplexArrayList";
 	maxEpsilon = maxE;
 	maxDimension = maxD;
-	distMatrix = _distMatrix;
+	distMatrix = std::move(_distMatrix);
 	indexCount = 0;
 }
 
@@ -54,11 +59,26 @@ void simplexArrayList::insert(std::vector<double> &vector){
 		
 		unsigned i = weightedGraph[0].size();
 		vertex = {i};
-		if(maxDimension > 0){
+		
+		//Sparse neighborhood graph: only visit the stored neighbors j < i
+		//	(each edge is seen once, no duplicate check needed)
+		if(maxDimension > 0 && !neighborGraph.empty()){
+			auto w = neighborGraph.weightsBegin(i);
+			for(auto j = neighborGraph.neighborsBegin(i); j != neighborGraph.neighborsEnd(i) && *j < i; j++, w++){
+				if(*w <= maxEpsilon){
+					std::vector<unsigned> edge = {*j,i};
+					
+					if(weightedGraph.size() == 1)
+						weightedGraph.push_back({std::make_pair(edge, *w)});
+					else
+						weightedGraph[1].push_back(std::make_pair(edge, *w));
+				}
+			}
+		} else if(maxDimension > 0){
 			//Iterate through each existing to compare to new insertion
 			for(unsigned j = 0; j < weightedGraph[0].size(); j++){
 				
-				auto dist = distMatrix[j][i];
+				auto dist = distMatrix(j, i);
 				
 				//Filter distances <= maxEpsilon, > 0 (same point)
 				if(dist <= maxEpsilon){
@@ -95,7 +115,7 @@ std::vector<std::vector<unsigned>> simplexArrayList::getDimEdges(int dim, double
 		bool isTrue = true;
 		for(int i = 0; i < a.first.size(); i++){
 			for(int j = i+1; j < a.first.size(); j++){
-				if(distMatrix[a.first[i]][a.first[j]] > epsilon){
+				if(distance(a.first[i], a.first[j]) > epsilon){
 					isTrue =false;
 					//weightedGraph[dim-1].erase(weightedGraph[dim-1].begin() + a);
 					break;
@@ -112,14 +132,14 @@ std::vector<std::vector<unsigned>> simplexArrayList::getDimEdges(int dim, double
 }
 
 // Wrapper to expose edges
-std::vector<std::vector<std::pair<std::set<unsigned>, double>>> simplexArrayList::getAllEdges(double epsilon){
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> ret;
+std::vector<std::vector<std::pair<smallSimplex, double>>> simplexArrayList::getAllEdges(double epsilon){
+	std::vector<std::vector<std::pair<smallSimplex, double>>> ret;
 	
 	for(auto dim : weightedGraph){
-		std::vector<std::pair<std::set<unsigned>,double>> dimGraph;
+		std::vector<std::pair<smallSimplex, double>> dimGraph;
 		
 		for(auto edge : dim){
-			std::set<unsigned> curSet;
+			smallSimplex curSet;
 			std::copy(edge.first.begin(), edge.first.end(), std::inserter(curSet, curSet.end()));
 			dimGraph.push_back(std::make_pair(curSet, edge.second));			
 		}
@@ -135,42 +155,79 @@ std::vector<std::vector<std::pair<std::set<unsigned>, double>>> simplexArrayList
 	return ret;
 }
 
+// Keyed index of the d-dimensional simplices, extended with any simplices appended since
+//		the last lookup; nullptr if the keys of this dimension would overflow 64 bits
+const simplexHash* simplexArrayList::dimIndex(unsigned d){
+	if(weightedGraph.size() <= d)
+		return nullptr;
+	
+	if(simplexIndex.size() <= d){
+		simplexIndex.resize(d + 1);
+		indexedCount.resize(d + 1, 0);
+	}
+	
+	auto& graph = weightedGraph[d];
+	if(indexedCount[d] < graph.size()){
+		binomials.reserve(vertexCount(), d + 1);
+		if(!binomials.fits(vertexCount(), d + 1))
+			return nullptr;
+		
+		simplexIndex[d].reserve(graph.size());
+		for(unsigned v = indexedCount[d]; v < graph.size(); v++)
+			simplexIndex[d].insert(binomials.key(graph[v].first), graph[v].second, v);
+		indexedCount[d] = graph.size();
+	}
+	
+	return &simplexIndex[d];
+}
+
+// Position of a (sorted) simplex in weightedGraph[d], noSimplex if not present
+//		O(1) keyed lookup, falls back to a linear scan when the dimension can't be keyed
+unsigned simplexArrayList::position(const std::vector<unsigned>& vector){
+	if(vector.empty() || weightedGraph.size() < vector.size())
+		return noSimplex;
+	
+	auto index = dimIndex(vector.size() - 1);
+	if(index != nullptr){
+		//Stored simplices are sorted; an unsorted or out of range vertex list can't match
+		if(std::adjacent_find(vector.begin(), vector.end(), std::greater_equal<unsigned>()) != vector.end() || vector.back() >= vertexCount())
+			return noSimplex;
+		return index->position(binomials.key(vector));
+	}
+	
+	auto& graph = weightedGraph[vector.size() - 1];
+	for(unsigned v = 0; v < graph.size(); v++){
+		if(graph[v].first == vector)
+			return v;
+	}
+	return noSimplex;
+}
+
 // Search function to find a specific vector in the simplexArrayList
 // weightedGraph[d][v][p] dimension d stores vectors v of point elements p of simplexes formed
 bool simplexArrayList::find(std::vector<unsigned> vector){
-	
-	if(weightedGraph.size() >= vector.size()){
-		//Search the weighted graph from the size of the vector
-		for(auto v = 0; v < weightedGraph[vector.size() - 1].size(); v++){
-			//ut.print1DVector(weightedGraph[vector.size() - 1][v]);
-			
-			if(weightedGraph[vector.size() - 1][v].first == vector){
-				return true;
-			}
-		}
-	}
-	return false;
+	return position(vector) != noSimplex;
+}
+
+// Storage position of a simplex in its dimension, noSimplex if not present
+unsigned simplexArrayList::findIndex(smallSimplex simplex){
+	return position(std::vector<unsigned>(simplex.begin(), simplex.end()));
 }
 
 // Search function to find a specific vector in the simplexArrayList
 // weightedGraph[d][v][p] dimension d stores vectors v of point elements p of simplexes formed
 double simplexArrayList::findWeight(std::vector<unsigned> vector){
-	//Search the weighted graph from the size of the vector
-	for(auto v = 0; v < weightedGraph[vector.size() - 1].size(); v++){
-		//ut.print1DVector(weightedGraph[vector.size() - 1][v]);
-		
-		if(weightedGraph[vector.size() - 1][v].first == vector){
-			return weightedGraph[vector.size() - 1][v].second;
-		}
-	}
-	return -1;
+	unsigned v = position(vector);
+	if(v == noSimplex)
+		return -1;
+	return weightedGraph[vector.size() - 1][v].second;
 }
 
 // Output the total simplices stored in the simplical complex
 int simplexArrayList::simplexCount(){
 	int simplexRet = 0;
 	
-	for(auto a : weightedGraph){
+	for(auto& a : weightedGraph){
 		simplexRet += a.size();
 	}
 	
@@ -184,206 +241,176 @@ int simplexArrayList::vertexCount(){
 	return weightedGraph[0].size();
 }
 
-// Expand the simplexArrayList to incorporate higher-level simplices 
-//	-> O(d((n+1)(n+2)/2)) -> O(dn^2) -> where n is the number of d-1 simplices
-//		Sequence: 0 , 1 , 3 , 6 , 10 , 15
-//		(AKA very inefficient)
+// Expand the simplexArrayList to incorporate higher-level simplices (flag complex)
+//	-> O(sum over d-1 simplices of the vertex neighbor list lengths) per dimension
 //
-//	Do this by comparing each simplex to subsequent simplices; if they intersect
-//		with a face, search for the remaining faces
+//	Each vertex keeps its sorted upper neighbors (larger vertices it shares an edge with);
+//		a simplex is extended only by the vertices in the intersection of its vertices'
+//		upper neighbor lists. Every d-simplex is built exactly once, from the face without
+//		its largest vertex, with the weight of its longest edge.
 //
+//	With threads > 1 the (d-1)-simplices are split into chunks claimed by the workers;
+//		each chunk expands into its own buffer and the buffers are appended in chunk
+//		order, so the result matches the single threaded expansion.
 //
-void simplexArrayList::expandDimensions(int dim){	
+void simplexArrayList::expandDimensions(int dim){
+	
+	if(weightedGraph.size() < 2 || reduced)
+		return;
 	
-	std::vector<unsigned> tempVect;	
+	//Upper neighbors (vertex, edge weight) of each vertex, sorted by vertex
+	std::vector<std::vector<std::pair<unsigned, double>>> upper(vertexCount());
+	for(auto& edge : weightedGraph[1])
+		upper[edge.first[0]].push_back(std::make_pair(edge.first[1], edge.second));
+	for(auto& neighbors : upper)
+		std::sort(neighbors.begin(), neighbors.end());
 	
-	//Iterate up to max dimension of simplex, starting at dim 2 (edges)
+	//Iterate up to max dimension of simplex, starting at dim 2 (triangles)
 	for(unsigned d = 2; d <= dim; d++){
 		
-		//Check if we need to break from expanding dimensions (no more edges)
+		//Check if we need to break from expanding dimensions (no more simplices)
 		if(weightedGraph.size() < d)
 			break;
 		
-		//Store d-dimensional simplices
-		std::vector<std::vector<unsigned>> test;
+		//A repeated expansion only adds the simplices not already stored; build the
+		//		keyed index up front so the workers' lookups are read only
+		bool existing = weightedGraph.size() > d;
+		if(existing)
+			dimIndex(d);
 		
-		//Iterate through each element in the current dimension's edges
-		for(unsigned j = 0; j < weightedGraph[d-1].size(); j++){
+		auto& faces = weightedGraph[d-1];
+		unsigned chunkCount = (faces.size() + expandChunk - 1) / expandChunk;
+		std::vector<std::vector<std::pair<std::vector<unsigned>, double>>> expanded(chunkCount);
+		std::atomic<unsigned> nextChunk(0);
+		
+		auto worker = [&](unsigned){
+			std::vector<std::pair<unsigned, double>> candidates, common;
 			
-			//First search for intersections of the current element
-			for(unsigned t = j+1; t < weightedGraph[d-1].size(); t++){
-					
-				//Symmetric Diff will give us the 
-				auto simp = ut.symmetricDiff(weightedGraph[d-1][j].first, weightedGraph[d-1][t].first,true);
-				std::vector<unsigned> totalVector = simp;
-				double maxWeight = weightedGraph[d-1][j].second > weightedGraph[d-1][t].second ? weightedGraph[d-1][j].second : weightedGraph[d-1][t].second;
-				
-				
-				//This point intersects; potential candidate for a higher-level simplice
-				//	Note - this is supposed to be 2, and will always be 2
-				if (simp.size() == 2){
-					
-					bool create = true;
-					auto m = ut.setIntersect(weightedGraph[d-1][j].first,weightedGraph[d-1][t].first,true);
+			for(unsigned c = nextChunk++; c < chunkCount; c = nextChunk++){
+				for(unsigned j = c * expandChunk; j < std::min<unsigned>(faces.size(), (c + 1) * expandChunk); j++){
+					auto& face = faces[j];
 					
-					//Case that we have a single vertex as the intersect
-					if(m.size() == 1){
-						std::vector<unsigned> searchVector = simp;
-						
-						sort(searchVector.begin(), searchVector.end());
-						totalVector = searchVector;
-						for(auto pt : m)
-							totalVector.push_back(pt);
-				
-						sort(totalVector.begin(), totalVector.end());
-						
-						double wt = 0;
-						if((wt = findWeight(searchVector)) < 0){
-							create = false;
-						} else if (wt > maxWeight)
-							maxWeight = wt;
-							
-						
-					
-					} else if(m.size() > 1){
-						
-						for(auto z : ut.getSubsets(m)){
-							
-							std::vector<unsigned> searchVector = simp;
-							for(unsigned pt : z){
-								searchVector.push_back(pt);
+					//Common upper neighbors of every vertex, with the longest edge to each
+					candidates = upper[face.first[0]];
+					for(unsigned k = 1; k < face.first.size() && !candidates.empty(); k++){
+						auto& neighbors = upper[face.first[k]];
+						common.clear();
+						auto a = candidates.begin();
+						auto b = neighbors.begin();
+						while(a != candidates.end() && b != neighbors.end()){
+							if(a->first < b->first)
+								a++;
+							else if(b->first < a->first)
+								b++;
+							else {
+								common.push_back(std::make_pair(a->first, std::max(a->second, b->second)));
+								a++;
+								b++;
 							}
-							totalVector = ut.setUnion(totalVector, searchVector, true);
-							
-							double wt = 0;
-							
-							if((wt = findWeight(searchVector)) < 0){
-								create = false;
-								break;
-							} else if (wt > maxWeight)
-								maxWeight = wt;
 						}
+						candidates.swap(common);
 					}
 					
-					if(create){
-						if(weightedGraph.size() == d){
-							std::vector<std::pair<std::vector<unsigned>, double>> tot = {std::make_pair(totalVector, maxWeight)};
-							weightedGraph.push_back(tot);
-						}else{
-							if(std::find(weightedGraph[d].begin(), weightedGraph[d].end(), std::make_pair(totalVector, maxWeight)) == weightedGraph[d].end()){
-								weightedGraph[d].push_back(std::make_pair(totalVector, maxWeight));
-							}
-						}
+					for(auto& vertex : candidates){
+						std::vector<unsigned> simplex = face.first;
+						simplex.push_back(vertex.first);
+						
+						if(existing && position(simplex) != noSimplex)
+							continue;
+						expanded[c].push_back(std::make_pair(simplex, std::max(face.second, vertex.second)));
 					}
 				}
 			}
-		}
+		};
+		
+		std::vector<std::thread> workers;
+		for(unsigned t = 1; t < std::min(threads, chunkCount); t++)
+			workers.push_back(std::thread(worker, t));
+		worker(0);
+		for(auto &w : workers)
+			w.join();
+		
+		size_t total = 0;
+		for(auto& chunk : expanded)
+			total += chunk.size();
+		if(total == 0)
+			continue;
+		
+		if(!existing)
+			weightedGraph.emplace_back();
+		weightedGraph[d].reserve(weightedGraph[d].size() + total);
+		for(auto& chunk : expanded)
+			std::move(chunk.begin(), chunk.end(), std::back_inserter(weightedGraph[d]));
 	} 
 	
-	//Sort the simplices by weight
-	for(auto a : weightedGraph){
-		std::sort(a.begin(), a.end(), std::greater<>());
-	}
-	
+	//Simplices stay in insertion order (positions are keyed by simplexIndex);
+	//		getAllEdges sorts its copy by weight
 	return;
 }
 
+// Filtration preserving elementary collapses (see simplexCollapse.hpp); the collapsed
+//		simplices are dropped from the weighted graph in one pass per dimension
+//
+//	The complex is first expanded through maxDimension + 1 (the top dimension the persistence
+//		stages expand to) and is not expanded again afterwards, which would restore the
+//		collapsed simplices
 void simplexArrayList::reduceComplex(){
 	
-	//Start with the largest dimension
+	expandDimensions(maxDimension + 1);
+	
 	ut.writeDebug("simplexArrayList","Reducing complex, starting simplex count: " + std::to_string(simplexCount()));
-	if(weightedGraph.size() == 0){
+	if(weightedGraph.size() < 3){
 		return;
 	}
+	reduced = true;
 	
-	for(auto i = weightedGraph.size()-1; i > 1; i--){
-		
-		std::vector<std::vector<unsigned>> removals;
-		std::vector<std::vector<unsigned>> checked;
-		std::vector<unsigned> currentSimplex;
-
-		while(checked.size() != weightedGraph[i].size()){
-			for(auto l : weightedGraph[i]){
-				if(std::find(checked.begin(),checked.end(),l.first) == checked.end()){
-					auto ret = recurseReduce(l, removals, checked);
-					removals = ret.first;
-					checked = ret.second;
-				}
-			}
-		}	
-		
-		//Remove the removals
-		for(auto rem : removals){
-			deletion(rem);
-		}
-			
+	std::vector<std::vector<std::pair<smallSimplex, double>>> chains(weightedGraph.size());
+	for(unsigned d = 0; d < weightedGraph.size(); d++){
+		chains[d].reserve(weightedGraph[d].size());
+		for(auto& simplex : weightedGraph[d])
+			chains[d].push_back(std::make_pair(smallSimplex(simplex.first.begin(), simplex.first.end()), simplex.second));
 	}
 	
-	ut.writeDebug("simplexArrayList","Finished reducing complex, reduced simplex count: " + std::to_string(simplexCount()));
+	auto removed = collapseComplex(chains);
+	chains.clear();
 	
-	return;
-}
-
-std::pair<std::vector<std::vector<unsigned>>, std::vector<std::vector<unsigned>>> simplexArrayList::recurseReduce(std::pair<std::vector<unsigned>,double> simplex, std::vector<std::vector<unsigned>> removals, std::vector<std::vector<unsigned>> checked){
-	checked.push_back(simplex.first);
-	auto subsets = ut.getSubsets(simplex.first);
-	std::vector<unsigned> maxFace;
-	
-	bool canRemove = true;
-	
-	//Look at each face
-	for(auto face : subsets){
-		
-		//Check if the face is shared; if so, recurse
-		for(auto simp : weightedGraph[simplex.first.size() - 1]){
-			
-			if(simp != simplex && std::find(checked.begin(), checked.end(), simp.first) == checked.end()){
-				auto sDiff = ut.symmetricDiff(simp.first, face,true);
-
-				//This point intersects;
-				if (sDiff.size() == 1){
-					auto ret = recurseReduce(simp, removals, checked);
-					removals = ret.first;
-					checked = ret.second;
-				
-					//Check if the simplex was not removed
-					if(std::find(removals.begin(), removals.end(), simp.first) == removals.end()){
-						canRemove = false;
-						break;
-					}
-				}
-				
-			}
+	for(unsigned d = 1; d < weightedGraph.size(); d++){
+		unsigned kept = 0;
+		for(unsigned i = 0; i < weightedGraph[d].size(); i++){
+			if(removed[d][i])
+				continue;
+			if(kept != i)
+				weightedGraph[d][kept] = std::move(weightedGraph[d][i]);
+			kept++;
 		}
+		if(kept == weightedGraph[d].size())
+			continue;
+		weightedGraph[d].resize(kept);
 		
-		//Check if the face is the max face
-		double wt = -1;
-		if((wt = findWeight(face)) == simplex.second){
-			maxFace = face;
+		//Positions shifted; rebuild the index on the next lookup
+		if(d < simplexIndex.size()){
+			simplexIndex[d].clear();
+			indexedCount[d] = 0;
 		}
-		
-	}	
-	
-	if(canRemove){
-		removals.push_back(simplex.first);
-		removals.push_back(maxFace);
-	}	
+	}
 	
-	return std::make_pair(removals, checked);
+	ut.writeDebug("simplexArrayList","Finished reducing complex, reduced simplex count: " + std::to_string(simplexCount()));
 	
+	return;
 }
 
 bool simplexArrayList::deletion(std::vector<unsigned> vector){
 	//Search the weighted graph from the size of the vector
-	for(auto v = 0; v < weightedGraph[vector.size() - 1].size(); v++){
-		//ut.print1DVector(weightedGraph[vector.size() - 1][v]);
-		
-		if(weightedGraph[vector.size() - 1][v].first == vector){
-			weightedGraph[vector.size() - 1].erase(weightedGraph[vector.size() - 1].begin() + v);
-			return true;
-		}
-	}
-	return false;
+	unsigned v = position(vector);
+	if(v == noSimplex)
+		return false;
+	
+	weightedGraph[vector.size() - 1].erase(weightedGraph[vector.size() - 1].begin() + v);
+	
+	//Positions after v shifted; rebuild the index on the next lookup
+	simplexIndex[vector.size() - 1].clear();
+	indexedCount[vector.size() - 1] = 0;
+	return true;
 }
 
 void simplexArrayList::clear(){
@@ -393,5 +420,8 @@ void simplexArrayList::clear(){
 	}
 	
 	weightedGraph.clear();
+	simplexIndex.clear();
+	indexedCount.clear();
+	reduced = false;
 	
 }
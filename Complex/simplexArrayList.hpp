@@ -8,20 +8,28 @@ class simplexArrayList : public simplexBase{
   private:
 	int indexCount;
 	std::string stats;
+	bool reduced = false;			//Collapsed by reduceComplex, no further expansion
+	static const unsigned expandChunk = 1024;	//(d-1)-simplices claimed at a time by an expansion worker
+	
+	//Keyed index of weightedGraph[d] (built lazily, cleared by deletion)
+	std::vector<simplexHash> simplexIndex;
+	std::vector<unsigned> indexedCount;
+	const simplexHash* dimIndex(unsigned);
+	unsigned position(const std::vector<unsigned>&);
   public:
-	simplexArrayList(double, double, std::vector<std::vector<double>>);
+	simplexArrayList(double, double, condensedDistMatrix&&);
 	double findWeight(std::vector<unsigned>);
-	std::pair<std::vector<std::vector<unsigned>>, std::vector<std::vector<unsigned>>> recurseReduce(std::pair<std::vector<unsigned>,double>, std::vector<std::vector<unsigned>>, std::vector<std::vector<unsigned>>);
 
 		
 	//virtual interface functions
 	double getSize();
 	void insert(std::vector<double>&);
 	bool find(std::vector<unsigned>);
+	unsigned findIndex(smallSimplex);
 	int simplexCount();
 	int vertexCount();
 	std::vector<std::vector<unsigned>> getDimEdges(int,double);
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> getAllEdges(double);
+	std::vector<std::vector<std::pair<smallSimplex, double>>> getAllEdges(double);
 	bool deletion(std::vector<unsigned>);
 	void expandDimensions(int);
 	void reduceComplex();
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <numeric>
 #include <typeinfo>
+#include <utility>
 #include "simplexBase.hpp"
 #include "simplexTree.hpp"
 #include "simplexArrayList.hpp"
@@ -43,12 +44,26 @@ void simplexBase::setConfig(std::map<std::string, std::string> configMap){
 	std::cout << "Setting utils for : " << simplexType << std::endl;
 	ut = utils(debug, outputFile);
 
+	//Simplices (and their cofaces) are stored inline, bounded by LHF_MAX_SIMPLEX_VERTICES
+	const int maxVertices = smallSimplex::capacity;
+	if(maxDimension + 2 > maxVertices){
+		ut.writeError(simplexType, "Dimension " + std::to_string(maxDimension) + " exceeds simplex capacity, limiting to " + std::to_string(maxVertices - 2) + " (rebuild with a larger LHF_MAX_SIMPLEX_VERTICES)");
+		maxDimension = maxVertices - 2;
+	}
+
 	return;
 }
 
 
-void simplexBase::setDistanceMatrix(std::vector<std::vector<double>> _distMatrix){
-	distMatrix = _distMatrix;
+// Take ownership of the distance matrix (moved, the caller's copy is left empty)
+void simplexBase::setDistanceMatrix(condensedDistMatrix&& _distMatrix){
+	distMatrix = std::move(_distMatrix);
+	return;
+}
+
+// Take ownership of the sparse epsilon-neighborhood graph (moved, as above)
+void simplexBase::setNeighborGraph(sparseNeighborGraph&& _neighborGraph){
+	neighborGraph = std::move(_neighborGraph);
 	return;
 }
 
@@ -57,15 +72,15 @@ simplexBase* simplexBase::newSimplex(const std::string &simplexT, std::map<std::
 	simplexType = simplexT;
 
 	if(simplexType == "simplexTree"){
-		auto t = new simplexTree(maxEpsilon, distMatrix, maxDimension);
+		auto t = new simplexTree(maxEpsilon, std::move(distMatrix), maxDimension);
 		t->setConfig(configMap);
 		return t;
 	} else if (simplexType == "simplexArrayList"){
-		auto t = new simplexArrayList(maxEpsilon, maxDimension, distMatrix);
+		auto t = new simplexArrayList(maxEpsilon, maxDimension, std::move(distMatrix));
 		t->setConfig(configMap);
 		return t;
 	} else if (simplexType == "indSimplexTree"){
-		auto t = new indSimplexTree(maxEpsilon, distMatrix, maxDimension);
+		auto t = new indSimplexTree(maxEpsilon, std::move(distMatrix), maxDimension);
 		t->setConfig(configMap);
 		return t;
 	}
@@ -79,9 +94,9 @@ std::vector<std::vector<unsigned>> simplexBase::getDimEdges(int dim, double epsi
 	return a;
 }
 
-std::vector<std::vector<std::pair<std::set<unsigned>,double>>> simplexBase::getAllEdges(double epsilon){
+std::vector<std::vector<std::pair<smallSimplex, double>>> simplexBase::getAllEdges(double epsilon){
 	ut.writeLog(simplexType,"No get edges function defined");
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> a;
+	std::vector<std::vector<std::pair<smallSimplex, double>>> a;
 	return a;
 }
 
@@ -112,16 +127,29 @@ void simplexBase::insert(std::vector<double>&){
 	return;
 }
 
+// Insert each (non-empty) point in order; the trees override this to build over the threads
+void simplexBase::insertAll(std::vector<std::vector<double>>& points){
+	for(auto& point : points)
+		if(!point.empty())
+			insert(point);
+	return;
+}
+
 bool simplexBase::find(std::vector<unsigned>){
 	ut.writeLog(simplexType,"No find function defined");
 	return false;
 }
 
-bool simplexBase::find(std::set<unsigned>){
+bool simplexBase::find(smallSimplex){
 	ut.writeLog(simplexType,"No find function defined");
 	return false;
 }
 
+unsigned simplexBase::findIndex(smallSimplex){
+	ut.writeLog(simplexType,"No find index function defined");
+	return noSimplex;
+}
+
 int simplexBase::vertexCount(){
 	ut.writeLog(simplexType,"No vertexCount function defined");
 	return -1;
@@ -171,7 +199,7 @@ bool simplexBase::streamEvaluator(std::vector<double>& vector, std::vector<std::
 
 	std::sort(reps.begin(), reps.end());
 	std::vector<double> kNN;
-	int k = 20;
+	int k = std::min<int>(20, reps.size());
 
 	for(int i = 0; i < k; i++){
 		kNN.push_back(reps[i]);
@@ -4,6 +4,9 @@
 #include <set>
 #include <iostream>
 #include "utils.hpp"
+#include "condensedDistMatrix.hpp"
+#include "sparseNeighborGraph.hpp"
+#include "simplexHash.hpp"
 
 // Header file for simplexBase class - see simplexTree.cpp for descriptions
 
@@ -20,59 +23,40 @@ class simplexBase {
 		indTreeNode* child = nullptr;
 		indTreeNode* sibling = nullptr;
 		indTreeNode* parent = nullptr;
-		std::set<unsigned> simplexSet;
-		double weight = 0;
+		smallSimplex simplexSet;
+		filtrationValue weight = 0;
 	};
 
 	struct graphEntry{
-		std::set<unsigned> simplexSet;
-		double weight = 0;
+		smallSimplex simplexSet;
+		filtrationValue weight = 0;
 		indTreeNode* entry = nullptr;
 
 		graphEntry(){}
-		graphEntry(std::set<unsigned> simp, double wt, indTreeNode* ent) {
+		graphEntry(smallSimplex simp, double wt, indTreeNode* ent) {
 			simplexSet = simp; weight = wt; entry = ent;
 		}
 
-		//Iteratively build subsets (faces) of the simplex set
-		std::vector<std::set<unsigned>> getAllSubsets(std::set<unsigned> set){
-			std::vector<std::set<unsigned>> subset;
-			std::set<unsigned> empty;
-			subset.push_back(empty);
+		//Faces (codimension 1 subsets) of the simplex set, built inline
+		std::vector<smallSimplex> getAllSubsets(smallSimplex set){
+			std::vector<smallSimplex> retSubset;
+			retSubset.reserve(set.size());
 
-			//For each set in the
-			for(auto i = set.begin(); i!= set.end(); i++){
-				std::vector<std::set<unsigned>> subsetTemp = subset;
-				unsigned entry = *i;
+			for(unsigned k = 0; k < set.size(); k++)
+				retSubset.push_back(set.face(k));
 
-				for (unsigned j = 0; j < subsetTemp.size(); j++){
-					subsetTemp[j].insert(entry);
-				}
-
-				unsigned z = 0;
-				for (auto j = subsetTemp.begin(); j != subsetTemp.end(); j++){
-					subset.push_back(*j);
-
-				}
-			}
-
-			std::vector<std::set<unsigned>> retSubset;
-
-			for(std::set<unsigned> z : subset){
-				if(z.size() == simplexSet.size() - 1)
-					retSubset.push_back(z);
-			}
 			return retSubset;
 		}
 
 
+		//Sorted positions of the faces in the complex (keyed lookups, no scan)
 		std::set<unsigned> getFaces(simplexBase* simpTree){
 			std::set<unsigned> indexes;
 
-			std::vector<std::set<unsigned>> subsets = getAllSubsets(simplexSet);
-
-			for(auto z : subsets){
-				indexes.insert(simpTree->find(z));
+			for(unsigned k = 0; k < simplexSet.size(); k++){
+				unsigned index = simpTree->findIndex(simplexSet.face(k));
+				if(index != noSimplex)
+					indexes.insert(index);
 			}
 
 			return indexes;
@@ -81,9 +65,12 @@ class simplexBase {
 
 	std::vector<unsigned> dimCounts = {6, 15, 20};
 	std::string simplexType = "simplexBase";
-	double maxEpsilon;
-	int maxDimension;
-	std::vector<std::vector<double>> distMatrix;
+	double maxEpsilon = 0;
+	int maxDimension = 0;
+	unsigned threads = 1;			//Worker threads for the parallel insertion / expansion (set by neighGraph, ripsPipe)
+	condensedDistMatrix distMatrix;
+	sparseNeighborGraph neighborGraph;
+	binomialTable binomials;
 	std::vector<std::vector<std::pair<std::vector<unsigned>, double>>> weightedGraph;
 	int runningVectorCount = 0;
 	std::vector<int> runningVectorIndices;
@@ -94,7 +81,12 @@ class simplexBase {
 	simplexBase(std::map<std::string, std::string>);
 	simplexBase(double, int);
 	void setConfig(std::map<std::string, std::string>);
-	void setDistanceMatrix(std::vector<std::vector<double>> _distMatrix);
+	void setDistanceMatrix(condensedDistMatrix&& _distMatrix);
+	void setNeighborGraph(sparseNeighborGraph&& _neighborGraph);
+
+	//Pairwise distance from the neighborhood graph if one was built, else the distance matrix
+	double distance(unsigned i, unsigned j) const { return neighborGraph.empty() ? distMatrix(i,j) : neighborGraph(i,j); };
+	bool hasDistances() const { return !distMatrix.empty() || !neighborGraph.empty(); };
 	simplexBase* newSimplex(const std::string &simplexT, std::map<std::string, std::string> configMap);
 	bool (*streamEval) (std::vector<double>&, std::vector<std::vector<double>>&);
     bool streamEvaluator(std::vector<double>&, std::vector<std::vector<double>>&);
@@ -105,12 +97,14 @@ class simplexBase {
 	virtual bool insertIterative(std::vector<double>&, std::vector<std::vector<double>>&);
 	virtual void deleteIterative(int, int);
 	virtual void insert(std::vector<double>&);
+	virtual void insertAll(std::vector<std::vector<double>>&);
 	virtual bool find(std::vector<unsigned>);
-	virtual bool find(std::set<unsigned>);
+	virtual bool find(smallSimplex);
+	virtual unsigned findIndex(smallSimplex);
 	virtual int simplexCount();
 	virtual int vertexCount();
 	virtual std::vector<std::vector<unsigned>> getDimEdges(int,double);
-	virtual std::vector<std::vector<std::pair<std::set<unsigned>, double>>> getAllEdges(double);
+	virtual std::vector<std::vector<std::pair<smallSimplex, double>>> getAllEdges(double);
 	virtual std::vector<std::vector<graphEntry>> getIndexEdges(double);
 	virtual void expandDimensions(int);
 	virtual void reduceComplex();
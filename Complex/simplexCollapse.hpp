@@ -0,0 +1,122 @@
+#pragma once
+
+#ifndef SIMPLEXCOLLAPSE_HPP_INCL
+#define SIMPLEXCOLLAPSE_HPP_INCL
+
+#include <vector>
+#include <deque>
+#include "simplexHash.hpp"
+
+// Header only filtration preserving elementary collapses (used by reduceComplex)
+//		A face t is free if its only coface s is maximal; when t and s enter the filtration
+//		at the same value, removing both is a collapse at every filtration value, so the
+//		persistence is unchanged.
+//
+//		Each simplex keeps a count of its remaining cofaces and the XOR of their ids, so the
+//		coface of a free face is read directly. Faces whose count drops to one (or whose
+//		coface becomes maximal) go on a worklist; each simplex is removed once and touches
+//		its faces once, so a pass is linear in the size of the complex.
+
+// Simplices removed from a complex given as (simplex, weight) lists by dimension; removed[d][i]
+//		is set for chains[d][i]. Only pairs with the coface of dimension >= minDim are
+//		collapsed (vertices are kept). Returns no removals if the simplex keys would overflow.
+template<typename Chain>
+std::vector<std::vector<char>> collapseComplex(const std::vector<Chain>& chains, unsigned minDim = 2){
+	std::vector<std::vector<char>> removed(chains.size());
+	for(unsigned d = 0; d < chains.size(); d++)
+		removed[d].assign(chains[d].size(), 0);
+	if(minDim == 0)
+		minDim = 1;
+	if(chains.size() <= minDim)
+		return removed;
+
+	//Global ids: dimension offsets into flat counter arrays
+	std::vector<size_t> offset(chains.size() + 1, 0);
+	for(unsigned d = 0; d < chains.size(); d++)
+		offset[d + 1] = offset[d] + chains[d].size();
+
+	//Faces of each simplex of dimension >= minDim (rows[d][i * (d+1) + k] in chains[d-1])
+	std::vector<std::vector<unsigned>> rows(chains.size());
+	for(unsigned d = minDim; d < chains.size(); d++){
+		rows[d] = boundaryRows(chains[d - 1], chains[d]);
+		if(rows[d].size() != chains[d].size() * (d + 1))
+			return removed;
+	}
+
+	std::vector<unsigned> cofaces(offset.back(), 0);
+	std::vector<size_t> cofaceIds(offset.back(), 0);
+	std::vector<char> gone(offset.back(), 0);
+	std::deque<size_t> worklist;
+
+	auto dimOf = [&](size_t id){
+		unsigned d = 0;
+		while(offset[d + 1] <= id) d++;
+		return d;
+	};
+
+	//Call f(face id) for each face of id that can be collapsed
+	auto forFaces = [&](size_t id, unsigned d, auto f){
+		if(d < minDim)
+			return;
+		size_t i = id - offset[d];
+		for(unsigned k = 0; k <= d; k++){
+			unsigned row = rows[d][i * (d + 1) + k];
+			if(row != noSimplex)
+				f(offset[d - 1] + row);
+		}
+	};
+
+	for(unsigned d = minDim; d < chains.size(); d++){
+		for(size_t id = offset[d]; id < offset[d + 1]; id++){
+			forFaces(id, d, [&](size_t face){
+				cofaces[face]++;
+				cofaceIds[face] ^= id;
+			});
+		}
+	}
+	for(size_t id = offset[minDim - 1]; id < offset[chains.size() - 1]; id++)
+		if(cofaces[id] == 1)
+			worklist.push_back(id);
+
+	//Remove a simplex; faces left with one coface, or none (maximal), are revisited
+	auto remove = [&](size_t id, unsigned d){
+		gone[id] = 1;
+		forFaces(id, d, [&](size_t face){
+			cofaces[face]--;
+			cofaceIds[face] ^= id;
+			if(cofaces[face] == 1)
+				worklist.push_back(face);
+			else if(cofaces[face] == 0)
+				forFaces(face, d - 1, [&](size_t f){
+					if(cofaces[f] == 1)
+						worklist.push_back(f);
+				});
+		});
+	};
+
+	while(!worklist.empty()){
+		size_t t = worklist.front();
+		worklist.pop_front();
+		if(gone[t] || cofaces[t] != 1)
+			continue;
+
+		size_t s = cofaceIds[t];
+		if(cofaces[s] != 0)
+			continue;
+
+		unsigned d = dimOf(t);
+		if(chains[d][t - offset[d]].second != chains[d + 1][s - offset[d + 1]].second)
+			continue;
+
+		remove(s, d + 1);
+		remove(t, d);
+	}
+
+	for(unsigned d = 0; d < chains.size(); d++)
+		for(size_t i = 0; i < chains[d].size(); i++)
+			removed[d][i] = gone[offset[d] + i];
+
+	return removed;
+}
+
+#endif
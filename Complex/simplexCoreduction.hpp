@@ -0,0 +1,138 @@
+#pragma once
+
+#ifndef SIMPLEXCOREDUCTION_HPP_INCL
+#define SIMPLEXCOREDUCTION_HPP_INCL
+
+#include <vector>
+#include <deque>
+#include "simplexHash.hpp"
+#include "unionFind.hpp"
+
+// Header only filtration preserving coreductions (see Mrozek-Batko-09, Mischaikow-Nanda-13)
+//		A coreduction pair (a, b) has a as the only remaining face of b; removing both (and
+//		dropping them from the boundaries of their cofaces) is a reduction of the chain
+//		complex. When a and b enter the filtration at the same value it is a reduction at
+//		every filtration value, so the persistence is unchanged.
+//
+//		Coreductions need cells whose boundary has been emptied to start from. Above
+//		dimension 0 the pairs of the persistence stage come from the boundary matrices
+//		of the triangles and up, where the rows of the negative edges (the union-find
+//		merges) can be left out (compression, see Bauer-Kerber-Reininghaus-14). Vertices and
+//		merge edges are therefore taken out of every boundary first; triangles on two merge
+//		edges are the first coreduction pairs. Merge edges are never removed, so the H0
+//		intervals (union-find over the remaining edges) are unchanged as well.
+//
+//		Each simplex keeps a count of its remaining faces and the XOR of their ids, so the
+//		face of a pair is read directly. Cofaces whose count drops to one go on a queue;
+//		each simplex is removed once and touches its cofaces once.
+
+// Simplices removed from a complex given as (simplex, weight) lists by dimension, edges sorted
+//		by weight (getAllEdges order); removed[d][i] is set for chains[d][i]. The persistence
+//		stage must leave the rows of the merge edges out of the triangle boundaries (see
+//		negativeSimplices). Returns no removals if the simplex keys would overflow.
+template<typename Chain>
+std::vector<std::vector<char>> coreduceComplex(const std::vector<Chain>& chains){
+	std::vector<std::vector<char>> removed(chains.size());
+	for(unsigned d = 0; d < chains.size(); d++)
+		removed[d].assign(chains[d].size(), 0);
+	if(chains.size() < 3)
+		return removed;
+
+	//Global ids: dimension offsets into flat counter arrays (vertices have no ids)
+	std::vector<size_t> offset(chains.size() + 1, 0);
+	for(unsigned d = 1; d < chains.size(); d++)
+		offset[d + 1] = offset[d] + chains[d].size();
+
+	//Faces of each simplex of dimension >= 2 (rows[d][i * (d+1) + k] in chains[d-1])
+	std::vector<std::vector<unsigned>> rows(chains.size());
+	for(unsigned d = 2; d < chains.size(); d++){
+		rows[d] = boundaryRows(chains[d - 1], chains[d]);
+		if(rows[d].size() != chains[d].size() * (d + 1))
+			return removed;
+	}
+
+	std::vector<unsigned> faces(offset.back(), 0);
+	std::vector<size_t> faceIds(offset.back(), 0);
+	std::vector<char> gone(offset.back(), 0);
+	std::deque<size_t> queue;
+
+	//Merge edges are out of every boundary from the start
+	for(auto merge : zeroPersistence(chains[0], chains[1]))
+		gone[offset[1] + merge.edge] = 1;
+
+	//Cofaces by id (CSR); coface k of id at cofaceList[cofaceStart[id] + k]
+	std::vector<size_t> cofaceStart(offset.back() + 1, 0);
+	for(unsigned d = 2; d < chains.size(); d++)
+		for(auto row : rows[d])
+			if(row != noSimplex)
+				cofaceStart[offset[d - 1] + row + 1]++;
+	for(size_t id = 0; id < offset.back(); id++)
+		cofaceStart[id + 1] += cofaceStart[id];
+
+	std::vector<size_t> cofaceList(cofaceStart.back());
+	std::vector<size_t> fill(cofaceStart.begin(), cofaceStart.end() - 1);
+	for(unsigned d = 2; d < chains.size(); d++){
+		for(size_t i = 0; i < chains[d].size(); i++){
+			size_t id = offset[d] + i;
+			for(unsigned k = 0; k <= d; k++){
+				unsigned row = rows[d][i * (d + 1) + k];
+				if(row == noSimplex)
+					continue;
+				size_t face = offset[d - 1] + row;
+				cofaceList[fill[face]++] = id;
+				if(!gone[face]){
+					faces[id]++;
+					faceIds[id] ^= face;
+				}
+			}
+			if(faces[id] == 1)
+				queue.push_back(id);
+		}
+	}
+	rows.clear();
+
+	auto dimOf = [&](size_t id){
+		unsigned d = 1;
+		while(offset[d + 1] <= id) d++;
+		return d;
+	};
+
+	auto weight = [&](size_t id, unsigned d){
+		return chains[d][id - offset[d]].second;
+	};
+
+	//Remove a simplex from the boundaries of its cofaces; cofaces left with one face are revisited
+	auto remove = [&](size_t id){
+		gone[id] = 1;
+		for(size_t k = cofaceStart[id]; k < cofaceStart[id + 1]; k++){
+			size_t coface = cofaceList[k];
+			if(gone[coface])
+				continue;
+			faces[coface]--;
+			faceIds[coface] ^= id;
+			if(faces[coface] == 1)
+				queue.push_back(coface);
+		}
+	};
+
+	while(!queue.empty()){
+		size_t b = queue.front();
+		queue.pop_front();
+		if(gone[b] || faces[b] != 1)
+			continue;
+
+		size_t a = faceIds[b];
+		unsigned d = dimOf(b);
+		if(weight(a, d - 1) != weight(b, d))
+			continue;
+
+		remove(b);
+		remove(a);
+		removed[d][b - offset[d]] = 1;
+		removed[d - 1][a - offset[d - 1]] = 1;
+	}
+
+	return removed;
+}
+
+#endif
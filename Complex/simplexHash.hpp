@@ -0,0 +1,216 @@
+#pragma once
+
+#ifndef SIMPLEXHASH_HPP_INCL
+#define SIMPLEXHASH_HPP_INCL
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstddef>
+#include "filtrationValue.hpp"
+
+// Header only simplex keys and key -> (filtration value, position) index
+//		A simplex {v_0 < v_1 < ... < v_k} is keyed by its rank in the combinatorial
+//		number system, sum_i C(v_i, i+1), which is unique among simplices with the
+//		same vertex count. Keys are looked up in an open addressing (linear probe)
+//		table, so face / coface lookups are a few binomial adds plus one probe.
+
+// Position returned for a simplex that is not in the complex
+const unsigned noSimplex = std::numeric_limits<unsigned>::max();
+
+// Binomial coefficients C(n, k) for n < vertices, k <= maxK
+//		Entries that overflow 64 bits saturate; fits() reports if every key
+//		for a vertex count is exact
+class binomialTable {
+  private:
+	std::vector<std::vector<unsigned long long>> table;		//table[k][n] = C(n, k)
+	unsigned vertices = 0;
+
+  public:
+	static const unsigned long long saturated = std::numeric_limits<unsigned long long>::max();
+
+	binomialTable(){};
+	binomialTable(unsigned n, unsigned maxK){ reserve(n, maxK); };
+
+	// Grow the table to n vertices and simplices of up to maxK vertices
+	void reserve(unsigned n, unsigned maxK){
+		if(n <= vertices && maxK < table.size())
+			return;
+		n = std::max(n, vertices);
+		maxK = std::max<unsigned>(maxK, table.empty() ? 0 : table.size() - 1);
+
+		table.assign(maxK + 1, std::vector<unsigned long long>(n + 1, 0));
+		for(unsigned i = 0; i <= n; i++)
+			table[0][i] = 1;
+		for(unsigned k = 1; k <= maxK; k++){
+			for(unsigned i = k; i <= n; i++){
+				unsigned long long a = table[k-1][i-1], b = table[k][i-1];
+				table[k][i] = (a == saturated || b == saturated || a > saturated - b) ? saturated : a + b;
+			}
+		}
+		vertices = n;
+	};
+
+	unsigned long long operator()(unsigned n, unsigned k) const { return table[k][n]; };
+
+	// True if keys of simplices with k vertices over n points are exact
+	bool fits(unsigned n, unsigned k) const { return k < table.size() && n <= vertices && table[k][n] != saturated; };
+
+	// Key of a sorted vertex range (smallSimplex or sorted std::vector<unsigned>)
+	template<typename S> unsigned long long key(const S& simplex) const {
+		unsigned long long ret = 0;
+		unsigned i = 1;
+		for(auto v : simplex)
+			ret += table[i++][v];
+		return ret;
+	};
+};
+
+
+class simplexHash {
+  public:
+	struct entry{
+		unsigned long long key;
+		filtrationValue weight;
+		unsigned position;
+	};
+
+  private:
+	static const unsigned long long emptyKey = std::numeric_limits<unsigned long long>::max();
+
+	std::vector<entry> slots;
+	size_t count = 0;
+	size_t mask = 0;
+
+	// splitmix64 finalizer, keys of neighbouring simplices are consecutive
+	static size_t hash(unsigned long long k){
+		k ^= k >> 30; k *= 0xbf58476d1ce4e5b9ULL;
+		k ^= k >> 27; k *= 0x94d049bb133111ebULL;
+		return (size_t)(k ^ (k >> 31));
+	};
+
+	void rehash(size_t capacity){
+		std::vector<entry> old;
+		old.swap(slots);
+		slots.assign(capacity, entry{emptyKey, 0, noSimplex});
+		mask = capacity - 1;
+		for(auto& e : old){
+			if(e.key != emptyKey){
+				size_t i = hash(e.key) & mask;
+				while(slots[i].key != emptyKey) i = (i + 1) & mask;
+				slots[i] = e;
+			}
+		}
+	};
+
+  public:
+	// Size the table for n simplices (load factor <= 1/2)
+	void reserve(size_t n){
+		size_t capacity = 16;
+		while(capacity < 2 * n) capacity <<= 1;
+		if(capacity > slots.size())
+			rehash(capacity);
+	};
+
+	void clear(){ slots.clear(); count = 0; mask = 0; };
+	size_t size() const { return count; };
+	bool empty() const { return count == 0; };
+
+	// Insert a key, returns false (and leaves the entry) if it is already present
+	bool insert(unsigned long long key, double weight, unsigned position){
+		if(2 * (count + 1) > slots.size())
+			rehash(slots.empty() ? 16 : 2 * slots.size());
+
+		size_t i = hash(key) & mask;
+		while(slots[i].key != emptyKey){
+			if(slots[i].key == key)
+				return false;
+			i = (i + 1) & mask;
+		}
+		slots[i] = entry{key, (filtrationValue)weight, position};
+		count++;
+		return true;
+	};
+
+	const entry* find(unsigned long long key) const {
+		if(count == 0)
+			return nullptr;
+		size_t i = hash(key) & mask;
+		while(slots[i].key != emptyKey){
+			if(slots[i].key == key)
+				return &slots[i];
+			i = (i + 1) & mask;
+		}
+		return nullptr;
+	};
+
+	unsigned position(unsigned long long key) const {
+		auto e = find(key);
+		return e == nullptr ? noSimplex : e->position;
+	};
+
+	// Remove a key, shifting the rest of its probe run back (no tombstones)
+	bool erase(unsigned long long key){
+		if(count == 0)
+			return false;
+		size_t i = hash(key) & mask;
+		while(slots[i].key != key){
+			if(slots[i].key == emptyKey)
+				return false;
+			i = (i + 1) & mask;
+		}
+
+		size_t j = i;
+		while(true){
+			j = (j + 1) & mask;
+			if(slots[j].key == emptyKey)
+				break;
+			size_t home = hash(slots[j].key) & mask;
+			//Move j back into the hole at i if its home slot is not in (i, j]
+			if(((j - home) & mask) >= ((j - i) & mask)){
+				slots[i] = slots[j];
+				i = j;
+			}
+		}
+		slots[i].key = emptyKey;
+		count--;
+		return true;
+	};
+};
+
+
+// Row (position in nChain) of each face of each pChain simplex, face k of column i at
+//		[i * stride + k] with stride the pChain vertex count; noSimplex for faces not in
+//		nChain. Chains are (simplex, weight) lists; empty if the keys would overflow
+template<typename Chain>
+std::vector<unsigned> boundaryRows(const Chain& nChain, const Chain& pChain){
+	std::vector<unsigned> rows;
+	if(pChain.empty())
+		return rows;
+
+	unsigned stride = pChain[0].first.size();
+	unsigned vertices = 0;
+	for(auto& s : nChain)
+		if(!s.first.empty()) vertices = std::max(vertices, *s.first.rbegin() + 1);
+	for(auto& s : pChain)
+		if(!s.first.empty()) vertices = std::max(vertices, *s.first.rbegin() + 1);
+
+	binomialTable binomials(vertices, stride);
+	if(stride == 0 || !binomials.fits(vertices, stride))
+		return rows;
+
+	simplexHash faceIndex;
+	faceIndex.reserve(nChain.size());
+	for(unsigned j = 0; j < nChain.size(); j++)
+		faceIndex.insert(binomials.key(nChain[j].first), nChain[j].second, j);
+
+	rows.assign(pChain.size() * stride, noSimplex);
+	for(unsigned i = 0; i < pChain.size(); i++){
+		for(unsigned k = 0; k < stride && k < pChain[i].first.size(); k++)
+			rows[i * stride + k] = faceIndex.position(binomials.key(pChain[i].first.face(k)));
+	}
+
+	return rows;
+}
+
+#endif
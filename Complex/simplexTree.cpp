@@ -3,11 +3,14 @@
 #include <vector>
 #include <unistd.h>
 #include <iostream>
+#include <functional>
 #include "simplexTree.hpp"
+#include "simplexCollapse.hpp"
+#include "lowerStar.hpp"
 
-simplexTree::simplexTree(double _maxEpsilon, std::vector<std::vector<double>> _distMatrix, int _maxDim){
+simplexTree::simplexTree(double _maxEpsilon, condensedDistMatrix&& _distMatrix, int _maxDim){
 	indexCounter = 0;
-	distMatrix = _distMatrix;
+	distMatrix = std::move(_distMatrix);
 	maxDimension = _maxDim;
 	maxEpsilon = _maxEpsilon;
 	simplexType = "simplexTree";
@@ -17,60 +20,58 @@ simplexTree::simplexTree(double _maxEpsilon, std::vector<std::vector<double>> _d
 //**													**//
 //** 				Private Functions 					**//
 //**													**//
-void simplexTree::recurseInsert(treeNode* node, unsigned curIndex, int depth, double maxE, std::set<unsigned> simp){
+void simplexTree::recurseInsert(unsigned node, unsigned curIndex, int depth, double maxE, smallSimplex simp){
 	//Incremental insertion
-	//Recurse to each child (which we'll use the parent pointer for...)
-	treeNode* temp;
-	std::set<unsigned> currentSimp = simp;
+	//Recurse to each child of the node
+	unsigned temp;
 
 	double curE = 0;
 
 	if(runningVectorIndices.size() < runningVectorCount+1){
 		int offset = runningVectorCount+1 - runningVectorIndices.size();
-		curE = distMatrix[node->index - offset][indexCounter - offset];
+		curE = distance(nodes[node].index - offset, indexCounter - offset);
 
 	}else{
-		curE = distMatrix[node->index][indexCounter];
+		curE = distance(nodes[node].index, indexCounter);
 	}
 
 	curE = curE > maxE ? curE : maxE;
 
 	//Check if the node needs inserted at this level
 	if(curE < maxEpsilon){
-		treeNode* insNode = new treeNode();
-		currentSimp.insert(curIndex);
-		insNode->index = curIndex;
-		insNode->simplex = currentSimp;
+		unsigned insNode = nodes.allocate();
+		nodes[insNode].index = curIndex;
+		nodes[insNode].parent = node;
 		nodeCount++;
-		simp.insert(node->index);
+		simp.insert(nodes[node].index);
 
 		//Get the largest weight of this simplex
-		maxE = curE > node->weight ? curE : node->weight;
-		insNode->weight = maxE;
+		maxE = curE > nodes[node].weight ? curE : nodes[node].weight;
+		nodes[insNode].weight = maxE;
 
 		//if depth (i.e. 1 for first iteration) is LT weightGraphSize (starts at 1)
 		if(weightEdgeGraph.size() < simp.size()){
-			std::vector<std::pair<std::set<unsigned>,double>> tempWEG;
+			std::vector<std::pair<smallSimplex, double>> tempWEG;
 			tempWEG.push_back(std::make_pair(simp, maxE));
 			weightEdgeGraph.push_back(tempWEG);
 		} else {
 			weightEdgeGraph[simp.size() - 1].push_back(std::make_pair(simp, maxE));
 		}
 
-		//Check if the node has children already... (remember parent == child for incremental)
-		if(node->parent == nullptr){
-			node->parent = insNode;
+		//Check if the node has children already; the new node goes to the front
+		if(nodes[node].child == nullNode){
+			nodes[node].child = insNode;
 
 		} else {
-			insNode->sibling = node->parent;
-			node->parent = insNode;
+			nodes[insNode].sibling = nodes[node].child;
+			nodes[node].child = insNode;
 
-			temp = insNode->sibling;
+			temp = nodes[insNode].sibling;
 			//Have to check the children now...
 			if(simp.size() <= maxDimension){
 				do {
 					recurseInsert(temp, curIndex, depth + 1, maxE, simp);
-				} while(temp->sibling != nullptr && (temp = temp->sibling) != nullptr);
+				} while((temp = nodes[temp].sibling) != nullNode);
 			}
 		}
 	}
@@ -78,24 +79,33 @@ void simplexTree::recurseInsert(treeNode* node, unsigned curIndex, int depth, do
 	return;
 }
 
+// Vertex set of a node, its index and the indices up the parent chain
+smallSimplex simplexTree::nodeSimplex(unsigned node){
+	smallSimplex simplex;
+	for(; node != nullNode; node = nodes[node].parent)
+		simplex.insert(nodes[node].index);
 
-void simplexTree::printTree(treeNode* head){
+	return simplex;
+}
+
+
+void simplexTree::printTree(unsigned head){
 	std::cout << "_____________________________________" << std::endl;
-	if(head == nullptr){
+	if(head == nullNode){
 		std::cout << "Empty tree... " << std::endl;
 		return;
 	}
 
-	std::cout << "HEAD: " << head->index << "," << head << "," << head->child << "," << head->sibling << std::endl;
+	std::cout << "HEAD: " << nodes[head].index << "," << head << "," << nodes[head].child << "," << nodes[head].sibling << std::endl;
 
-	treeNode* current;
+	unsigned current;
 	for(int i = 0; i < dimensions.size() ; i++){
 		std::cout << std::endl << "Dim: " << i << std::endl << std::endl;
 		current = dimensions[i];
 
 		do{
-			std::cout << current->index << "," << current << "," << current->sibling << "\t";
-		} while(current->sibling != nullptr && (current = current->sibling) != nullptr);
+			std::cout << nodes[current].index << "," << current << "," << nodes[current].sibling << "\t";
+		} while((current = nodes[current].sibling) != nullNode);
 
 		std::cout << std::endl;
 	}
@@ -105,9 +115,7 @@ void simplexTree::printTree(treeNode* head){
 }
 
 void simplexTree::insertInductive(){
-	//Create our new node to insert
-	treeNode* curNode = new treeNode;
-	curNode->index = indexCounter;
+	unsigned curNode;
 
 	//Loop each dimensional list; start at dn, then dn-1, ..., d0 (OLD WAY, INDUCTIVE VR)
 	for(int i = (dimensions.size()-1 < maxDimension ? dimensions.size() - 1 : maxDimension); i >= 0; i--){
@@ -119,29 +127,28 @@ void simplexTree::insertInductive(){
 			//Determine if the index needs to inserted below the current node
 			//	First, check the distance matrix for curNodeIndex v. curIndex
 			//	Second (if first is true), check all parents dist matrix of parentNodeIndex v. curIndex
-			if(distMatrix[curNode->index][indexCounter] < maxEpsilon){
+			if(distance(nodes[curNode].index, indexCounter) < maxEpsilon){
 
 				//	This node is a candidate, now we need to check each parent of the current branch
 				//		to ensure the distance matrix entry for parentNodeindex v. curIndex is < maxEpsilon
 				bool ins = true;
-				treeNode* parentNode = curNode; //Temporarily store the parent so we don't lose track of our current
+				unsigned parentNode = curNode; //Temporarily store the parent so we don't lose track of our current
 
 				// This loop will check each parent and set whether to insert a node
 				do{
-					if(distMatrix[parentNode->index][indexCounter] > maxEpsilon){
+					if(distance(nodes[parentNode].index, indexCounter) > maxEpsilon){
 						ins = false;
 					}
-				}while(ins && parentNode->parent != nullptr && (parentNode = parentNode->parent) != nullptr);
+				}while(ins && (parentNode = nodes[parentNode].parent) != nullNode);
 
 				//Insert the node; the distance to each parent is less than epsilon
 				if(ins){
 					//Allocate a new node to be inserted into the tree
-					treeNode* insNode = new treeNode;
+					unsigned insNode = nodes.allocate();
 
 					//This new node's parent is the current node we're indexing on
-					insNode->parent = curNode;
-					insNode->index = indexCounter;
-					insNode->sibling = nullptr;
+					nodes[insNode].parent = curNode;
+					nodes[insNode].index = indexCounter;
 
 					//Check the dimensional list
 					//	if no nodes exist at the dimension, this is the first
@@ -151,32 +158,32 @@ void simplexTree::insertInductive(){
 					//	Nodes currently exist at the dimension, insert as a sibling
 					//		This should be inserted with nodes of the same parent
 					} else {
-						treeNode* iterateNode = dimensions[i+1];
+						unsigned iterateNode = dimensions[i+1];
 						ins = false; //Store if we've inserted this node while looping through siblings
 
 						//Loop through dimensional node siblings
 						do{
 							//Check if we've found parent nodes...
-							if(iterateNode->parent == insNode->parent){
+							if(nodes[iterateNode].parent == curNode){
 								ins = true;
 
 								//perform an insertion of the node...
-								insNode->sibling = iterateNode->sibling;
-								iterateNode->sibling = insNode;
+								nodes[insNode].sibling = nodes[iterateNode].sibling;
+								nodes[iterateNode].sibling = insNode;
 
 								nodeCount++;
 							}
-						} while(!ins && iterateNode->sibling != nullptr && (iterateNode = iterateNode->sibling) != nullptr);
+						} while(!ins && nodes[iterateNode].sibling != nullNode && (iterateNode = nodes[iterateNode].sibling) != nullNode);
 
 						// Check if we successfully inserted a node; if not, insert to end
 						if(!ins){
-							iterateNode->sibling = insNode;
+							nodes[iterateNode].sibling = insNode;
 						}
 					}
 				}
 			}
 
-		}while(curNode->sibling != nullptr && (curNode = curNode->sibling) != nullptr);
+		}while((curNode = nodes[curNode].sibling) != nullNode);
 	}
 
 	return;
@@ -213,13 +220,7 @@ bool simplexTree::insertIterative(std::vector<double> &currentVector, std::vecto
 void simplexTree::deleteIterative(int keyToBeDeleted, int indexToBeDeleted)
 {
     // Delete the corresponding row and column from the distance matrix.
-    distMatrix.erase(distMatrix.begin() + indexToBeDeleted);
-
-    for(auto z : distMatrix)
-    {
-        if(z.size() >= indexToBeDeleted)
-            z.erase(z.begin() + indexToBeDeleted);
-    }
+    distMatrix.removePoint(indexToBeDeleted);
 
     //Delete all entries in the simplex tree with the index...
     // TODO :)
@@ -229,38 +230,43 @@ void simplexTree::deleteIterative(int keyToBeDeleted, int indexToBeDeleted)
 }
 
 
-void simplexTree::deleteIndexRecurse(int vectorIndex, treeNode* curNode){
+void simplexTree::deleteIndexRecurse(int vectorIndex, unsigned curNode){
 
-	if(curNode == nullptr){
+	if(curNode == nullNode){
 		std::cout << "Empty tree" << std::endl;
 		return;
 	}
 	//Handle siblings - either they need to be removed (and 'hopped') or recursed
-	if(curNode->sibling != nullptr && curNode->sibling->index == vectorIndex){
-		treeNode* tempNode = curNode->sibling;
-		curNode->sibling = curNode->sibling->sibling;
-		deleteIndexRecurse(vectorIndex, curNode->sibling);
-
-	} else if(curNode->sibling != nullptr){
-		deleteIndexRecurse(vectorIndex, curNode->sibling);
+	unsigned sibling = nodes[curNode].sibling;
+	if(sibling != nullNode && nodes[sibling].index == vectorIndex){
+		nodes[curNode].sibling = nodes[sibling].sibling;
+		nodes[sibling].sibling = nullNode;
+		deleteBranch(sibling);
+		if(nodes[curNode].sibling != nullNode)
+			deleteIndexRecurse(vectorIndex, nodes[curNode].sibling);
+
+	} else if(sibling != nullNode){
+		deleteIndexRecurse(vectorIndex, sibling);
 	}
 
 
-	if(curNode->index == vectorIndex){
+	if(nodes[curNode].index == vectorIndex){
 
 		if(curNode == head){
-			head = curNode->sibling;
+			head = nodes[curNode].sibling;
 			dimensions[0] = head;
 		}
 
-		deletion(curNode);
-	} else if (curNode->child != nullptr && curNode->child->index == vectorIndex){
-		treeNode* tempNode = curNode->child;
-		curNode->child = curNode->child->sibling;
-		deletion(tempNode);
+		nodes[curNode].sibling = nullNode;
+		deleteBranch(curNode);
+	} else if (nodes[curNode].child != nullNode && nodes[nodes[curNode].child].index == vectorIndex){
+		unsigned tempNode = nodes[curNode].child;
+		nodes[curNode].child = nodes[tempNode].sibling;
+		nodes[tempNode].sibling = nullNode;
+		deleteBranch(tempNode);
 
-	} else if(curNode->child != nullptr){
-		deleteIndexRecurse(vectorIndex, curNode->child);
+	} else if(nodes[curNode].child != nullNode){
+		deleteIndexRecurse(vectorIndex, nodes[curNode].child);
 	}
 
 	return;
@@ -272,27 +278,26 @@ void simplexTree::deleteIndexRecurse(int vectorIndex, treeNode* curNode){
 //
 void simplexTree::insert(std::vector<double>&) {
 
-	if(distMatrix.size() == 0){
+	if(!hasDistances()){
 		ut.writeDebug("simplexTree","Distance matrix is empty, skipping insertion");
 		return;
 	}
 
-	//Create our new node to insert
-	treeNode* curNode = new treeNode;
-	curNode->index = indexCounter;
-	std::set<unsigned> tempSet = {curNode->index};
+	smallSimplex tempSet = {indexCounter};
 	runningVectorIndices.push_back(runningVectorCount);
 
 	//Check if this is the first node (i.e. head)
 	//	If so, initialize the head node
-	if(head == nullptr){
-		head = curNode;
+	if(head == nullNode){
+		head = nodes.allocate();
+		nodes[head].index = indexCounter;
 		indexCounter++;
 		runningVectorCount++;
 		nodeCount++;
 		dimensions.push_back(head);
+		vertexNodes.push_back(head);
 
-		std::vector<std::pair<std::set<unsigned>,double>> tempWEG;
+		std::vector<std::pair<smallSimplex, double>> tempWEG;
 		tempWEG.push_back(std::make_pair(tempSet, 0));
 		weightEdgeGraph.push_back(tempWEG);
 
@@ -315,7 +320,7 @@ void simplexTree::insert(std::vector<double>&) {
 	//d3 --> | 2 | 3 |     | 4 | 5 |
 	//
 
-	treeNode* temp = dimensions[0];
+	unsigned temp = dimensions[0];
 
 	//Now let's do it the new way - incremental VR;
 	//	Start at the first dimension (d0);
@@ -325,18 +330,23 @@ void simplexTree::insert(std::vector<double>&) {
 	//			insert to current
 	//	iterate to d0->sibling
 
-	do{
-		recurseInsert(temp, indexCounter, 0, 0, tempSet);
-	}while(temp->sibling != nullptr && (temp = temp->sibling) != nullptr);
-
-	//Insert into the right of the tree
-	temp = dimensions[0];
-	treeNode* ins = new treeNode();
-	while(temp->sibling != nullptr && (temp = temp->sibling) != nullptr);
-	ins->index = indexCounter;
-	ins->sibling = nullptr;
-	ins->parent = nullptr;
-	temp->sibling = ins;
+	if(!neighborGraph.empty() && indexCounter < neighborGraph.size() && vertexNodes.size() == indexCounter){
+		//Sparse graph: only the stored (earlier) neighbors of the new point can share a simplex
+		//	with it; rows are sorted, so the vertices are visited in the same order
+		for(auto it = neighborGraph.neighborsBegin(indexCounter); it != neighborGraph.neighborsEnd(indexCounter) && *it < indexCounter; it++)
+			recurseInsert(vertexNodes[*it], indexCounter, 0, 0, tempSet);
+		temp = vertexNodes.back();
+	} else {
+		do{
+			recurseInsert(temp, indexCounter, 0, 0, tempSet);
+		}while(nodes[temp].sibling != nullNode && (temp = nodes[temp].sibling) != nullNode);
+	}
+
+	//Insert into the right of the tree (temp is the last vertex)
+	unsigned ins = nodes.allocate();
+	nodes[ins].index = indexCounter;
+	nodes[temp].sibling = ins;
+	vertexNodes.push_back(ins);
 	weightEdgeGraph[0].push_back(std::make_pair(tempSet, 0));
 
 	nodeCount++;
@@ -347,6 +357,81 @@ void simplexTree::insert(std::vector<double>&) {
 }
 
 
+// Insert every point (neighGraph); with threads > 1 on an empty tree the lower stars of the
+//		points are enumerated in parallel (see lowerStar.hpp) and linked here in point order
+void simplexTree::insertAll(std::vector<std::vector<double>>& points){
+	unsigned n = std::count_if(points.begin(), points.end(), [](const std::vector<double>& point){ return !point.empty(); });
+
+	if(threads <= 1 || head != nullNode || !hasDistances()){
+		simplexBase::insertAll(points);
+		return;
+	}
+
+	auto stars = lowerStars(*this, n, maxDimension, threads);
+
+	//Node of each depth on the current entry's path, and the last child matched below the
+	//		node of the depth above (entries under one node come largest vertex first)
+	std::vector<unsigned> pathNodes, matched;
+
+	for(unsigned k = 0; k < n; k++){
+		for(auto& entry : stars[k]){
+			unsigned node;
+			if(entry.depth == 0){
+				node = vertexNodes[entry.vertex];
+			} else {
+				node = matched[entry.depth] == nullNode ? nodes[pathNodes[entry.depth - 1]].child : matched[entry.depth];
+				while(nodes[node].index != entry.vertex)
+					node = nodes[node].sibling;
+				matched[entry.depth] = node;
+			}
+			pathNodes.resize(entry.depth + 1);
+			pathNodes[entry.depth] = node;
+			matched.resize(entry.depth + 2, nullNode);
+			matched[entry.depth + 1] = nullNode;
+
+			//Link the new node at the front of the children, as recurseInsert does
+			unsigned insNode = nodes.allocate();
+			nodes[insNode].index = k;
+			nodes[insNode].parent = node;
+			nodes[insNode].weight = entry.weight;
+			nodes[insNode].sibling = nodes[node].child;
+			nodes[node].child = insNode;
+			nodeCount++;
+
+			smallSimplex simp = {k};
+			for(auto pathNode : pathNodes)
+				simp.insert(nodes[pathNode].index);
+
+			if(weightEdgeGraph.size() < simp.size())
+				weightEdgeGraph.emplace_back();
+			weightEdgeGraph[simp.size() - 1].push_back(std::make_pair(simp, entry.weight));
+		}
+
+		//Append the vertex to the right of the tree
+		smallSimplex tempSet = {k};
+		runningVectorIndices.push_back(runningVectorCount);
+
+		unsigned ins = nodes.allocate();
+		nodes[ins].index = k;
+		if(head == nullNode){
+			head = ins;
+			dimensions.push_back(head);
+			weightEdgeGraph.emplace_back();
+		} else {
+			nodes[vertexNodes.back()].sibling = ins;
+		}
+		vertexNodes.push_back(ins);
+		weightEdgeGraph[0].push_back(std::make_pair(tempSet, 0));
+
+		nodeCount++;
+		indexCounter++;
+		runningVectorCount++;
+	}
+
+	return;
+}
+
+
 int simplexTree::vertexCount(){
 	//Return the number of vertices currently represented in the tree
 	if(runningVectorIndices.size() < runningVectorCount+1)
@@ -360,12 +445,12 @@ int simplexTree::simplexCount(){
 }
 
 double simplexTree::getSize(){
-	//Size of node: [int + byte (*) + byte (*)] = 18 Bytes
+	//Size of node: [index + 3 links + weight]
 	return nodeCount * sizeof(treeNode);
 }
 
 
-std::vector<std::vector<std::pair<std::set<unsigned>,double>>> simplexTree::getAllEdges(double epsilon){
+std::vector<std::vector<std::pair<smallSimplex, double>>> simplexTree::getAllEdges(double epsilon){
 
 	if(!isSorted){
 		for (int i = 0; i < weightEdgeGraph.size(); i++)
@@ -376,93 +461,61 @@ std::vector<std::vector<std::pair<std::set<unsigned>,double>>> simplexTree::getA
 	return weightEdgeGraph;
 }
 
+// Filtration preserving elementary collapses (see simplexCollapse.hpp); the collapsed
+//		simplices are unlinked from the tree and dropped from the weighted graph
 void simplexTree::reduceComplex(){
 	if(weightEdgeGraph.size() == 0){
 		ut.writeDebug("simplexTree","Complex is empty, skipping reduction");
 		return;
 	}
 
-	//Start with the largest dimension
 	ut.writeDebug("simplexTree","Reducing complex, starting simplex count: " + std::to_string(simplexCount()));
-	treeNode* cur;
-
-	if(dimensions.size() > 0){
-		for(auto i = dimensions.size()-1; i > 1; i--){
-
-			std::vector<std::set<unsigned>> removals;
-			std::vector<std::set<unsigned>> checked;
-
-			while(checked.size() != weightEdgeGraph[i].size()){
-				cur = dimensions[i];
-				do {
-					if(std::find(checked.begin(),checked.end(),cur->simplex) == checked.end()){
-						auto ret = recurseReduce(std::make_pair(cur->simplex, cur->weight), removals, checked);
-						removals = ret.first;
-						checked = ret.second;
-					}
-				} while (cur->sibling != nullptr && (cur = cur->sibling) != nullptr);
-			}
-
-			//Remove the removals
-			for(auto rem : removals){
-				deletion(rem);
-			}
-			std::cout << "Remove " << removals.size() << " from dim " << i << std::endl;
 
+	auto removed = collapseComplex(weightEdgeGraph);
+
+	//Keys of the removed simplices by dimension; removed simplices are closed under cofaces
+	std::vector<simplexHash> removedKeys(weightEdgeGraph.size());
+	binomials.reserve(indexCounter, weightEdgeGraph.size());
+	for(unsigned d = 1; d < weightEdgeGraph.size(); d++){
+		unsigned kept = 0;
+		for(unsigned i = 0; i < weightEdgeGraph[d].size(); i++){
+			if(removed[d][i])
+				removedKeys[d].insert(binomials.key(weightEdgeGraph[d][i].first), weightEdgeGraph[d][i].second, i);
+			else
+				weightEdgeGraph[d][kept++] = weightEdgeGraph[d][i];
 		}
+		weightEdgeGraph[d].resize(kept);
 	}
-	ut.writeDebug("simplexTree","Finished reducing complex, reduced simplex count: " + std::to_string(simplexCount()));
-
-	return;
-}
-
-std::pair<std::vector<std::set<unsigned>>, std::vector<std::set<unsigned>>> simplexTree::recurseReduce(std::pair<std::set<unsigned>,double> simplex, std::vector<std::set<unsigned>> removals, std::vector<std::set<unsigned>> checked){
-	checked.push_back(simplex.first);
-	auto subsets = ut.getSubsets(simplex.first);
-	std::set<unsigned> maxFace;
-
-	bool canRemove = true;
-
-	//Look at each face
-	for(auto face : subsets){
-
-		//Check if the face is shared; if so, recurse
-		for(auto simp : weightEdgeGraph[simplex.first.size() - 1]){
-
-			if(simp != simplex && std::find(checked.begin(), checked.end(), simp.first) == checked.end()){
-				auto sDiff = ut.symmetricDiff(simp.first, face,true);
-
-				//This point intersects;
-				if (sDiff.size() == 1){
-					auto ret = recurseReduce(simp, removals, checked);
-					removals = ret.first;
-					checked = ret.second;
-
-					//Check if the simplex was not removed
-					if(std::find(removals.begin(), removals.end(), simp.first) == removals.end()){
-						canRemove = false;
-						break;
-					}
-				}
 
+	//Walk each child list, releasing the branch of every removed simplex (its cofaces)
+	std::function<void(unsigned, const smallSimplex&)> prune = [&](unsigned parent, const smallSimplex& face){
+		unsigned prev = nullNode;
+		for(unsigned cur = nodes[parent].child; cur != nullNode;){
+			unsigned next = nodes[cur].sibling;
+			smallSimplex simplex = face;
+			simplex.insert(nodes[cur].index);
+
+			unsigned d = simplex.size() - 1;
+			if(d < removedKeys.size() && removedKeys[d].find(binomials.key(simplex)) != nullptr){
+				if(prev == nullNode)
+					nodes[parent].child = next;
+				else
+					nodes[prev].sibling = next;
+				nodes[cur].sibling = nullNode;
+				deleteBranch(cur);
+			} else {
+				prune(cur, simplex);
+				prev = cur;
 			}
+			cur = next;
 		}
+	};
+	for(unsigned vertex = head; vertex != nullNode; vertex = nodes[vertex].sibling)
+		prune(vertex, smallSimplex{nodes[vertex].index});
 
-		//Check if the face is the max face
-		double wt = -1;
-		if((wt = findWeight(face)) == simplex.second){
-			maxFace = face;
-		}
-
-	}
-
-	if(canRemove){
-		removals.push_back(simplex.first);
-		removals.push_back(maxFace);
-	}
-
-	return std::make_pair(removals, checked);
+	ut.writeDebug("simplexTree","Finished reducing complex, reduced simplex count: " + std::to_string(simplexCount()));
 
+	return;
 }
 
 
@@ -481,17 +534,16 @@ std::vector<std::vector<unsigned>> simplexTree::getDimEdges(int d,double){
 
 }
 
-bool simplexTree::find(std::set<unsigned>){
+bool simplexTree::find(smallSimplex){
 
-	ut.writeLog("simplexTree","find(std::set<unsigned>) not implemented!");
+	ut.writeLog("simplexTree","find(smallSimplex) not implemented!");
 	return 0;
 }
 
 // A recursive function to delete a simplex (and sub-branches) from the tree.
-bool simplexTree::deletion(std::set<unsigned> removalEntry) {
+bool simplexTree::deletion(smallSimplex removalEntry) {
 	//Remove the entry in the simplex tree
 	bool found = true;
-	treeNode* curNode = dimensions[0];
 	int d = removalEntry.size() - 1;
 
 
@@ -504,52 +556,32 @@ bool simplexTree::deletion(std::set<unsigned> removalEntry) {
 	}*/
 
 
-	ut.writeLog("simplexTree","deletion(std::set<unsigned>) not implemented!");
+	ut.writeLog("simplexTree","deletion(smallSimplex) not implemented!");
 	return false;
 
 }
 
 
-// A recursive function to delete a simplex (and sub-branches) from the tree.
-bool simplexTree::deletion(treeNode* removalEntry) {
-	treeNode* curNode = removalEntry;
-	int deletionCount = 0;
-
-	//Iterate to the bottom of branch in the current node
-	while(curNode->child != nullptr){
-		curNode->child->parent = curNode;
-		curNode=curNode->child;
-		std::cout << "\t\t@ " << curNode->index << std::endl;
-	}
-
-	if(curNode->sibling != nullptr){
-		deletion(curNode->sibling);
-	}
-
-	//If we did go down, remove on the way back up
-	while(curNode != removalEntry){
-		curNode = curNode->parent;
-
-		if(curNode->sibling != nullptr){
-			deletion(curNode->sibling);
-		}
+// Delete a node and its sub-branches (children and their siblings), returning them to the arena
+//		The node must already be unlinked from its sibling list
+bool simplexTree::deleteBranch(unsigned removalEntry) {
+	if(removalEntry == nullNode)
+		return false;
 
-		deletionCount++;
-		delete curNode->child;
-		curNode->child = nullptr;
+	for(unsigned child = nodes[removalEntry].child; child != nullNode; ){
+		unsigned next = nodes[child].sibling;
+		deleteBranch(child);
+		child = next;
 	}
 
-	//curNode = curNode->parent;
-	deletionCount++;
-	delete curNode;
+	nodes.release(removalEntry);
 	nodeCount--;
-	removalEntry->child = nullptr;
-	return false;
+	return true;
 }
 
-double simplexTree::findWeight(std::set<unsigned> simplex){
+double simplexTree::findWeight(smallSimplex simplex){
 
-	ut.writeLog("simplexTree","findWeight(std::set<unsigned>) not implemented!");
+	ut.writeLog("simplexTree","findWeight(smallSimplex) not implemented!");
 	return 1;
 }
 
@@ -563,16 +595,16 @@ std::vector<std::pair<double, std::vector<unsigned>>> simplexTree::getd0Pairs(){
 
 void simplexTree::clear(){
 
-	//Clear the simplexTree structure
-	deletion(head);
-	head = nullptr;
+	//Clear the simplexTree structure; the arena drops every node at once
+	nodes.reset();
+	head = nullNode;
+	nodeCount = 0;
 
 	//Clear the weighed edge graph
-	for(auto z : weightEdgeGraph){
-		z.clear();
-	}
 	weightEdgeGraph.clear();
 	dimensions.clear();
+	vertexNodes.clear();
+	isSorted = false;
 
 
 	//runningVectorCount = 0;
@@ -580,4 +612,3 @@ void simplexTree::clear(){
 	//indexCounter = 0;
 
 }
-
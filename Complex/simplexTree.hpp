@@ -1,5 +1,6 @@
 #pragma once
 #include "simplexBase.hpp"
+#include "nodeArena.hpp"
 #include <set>
 
 // Header file for simplexTree class - see simplexTree.cpp for descriptions
@@ -8,44 +9,48 @@ class simplexTree : public simplexBase {
   private:
 	bool isSorted = false;
 	unsigned indexCounter;
-	int nodeCount;
-	std::vector<std::vector<std::pair<std::set<unsigned>, double>>> weightEdgeGraph;
+	int nodeCount = 0;
+	std::vector<std::vector<std::pair<smallSimplex, double>>> weightEdgeGraph;
+	std::vector<unsigned> vertexNodes;			//Node of each vertex by index (sparse insertion)
 
 	void insertInductive();
 
   public:
+	//Nodes live in an arena and link by index (nullNode for none); the simplex of
+	//	a node is its index plus the indices up the parent chain (see nodeSimplex)
 	struct treeNode{
 		unsigned index;
-		std::set<unsigned> simplex;
-		treeNode* child = nullptr;
-		treeNode* sibling = nullptr;
-		treeNode* parent = nullptr;
-		double weight = 0;
+		unsigned child = nullNode;
+		unsigned sibling = nullNode;
+		unsigned parent = nullNode;
+		filtrationValue weight = 0;
 	};
 
-	treeNode* head;
-	std::vector<treeNode*> dimensions;
+	nodeArena<treeNode> nodes;
+	unsigned head = nullNode;
+	std::vector<unsigned> dimensions;
 
-	simplexTree(std::vector<std::vector<double>>);
-	simplexTree(double, std::vector<std::vector<double>>, int);
-	std::pair<std::vector<std::set<unsigned>>, std::vector<std::set<unsigned>>> recurseReduce(std::pair<std::set<unsigned>,double>, std::vector<std::set<unsigned>>, std::vector<std::set<unsigned>>);
-	void printTree(treeNode*);
-	void recurseInsert(treeNode*, unsigned, int, double, std::set<unsigned>);
-	double findWeight(std::set<unsigned>);
-	void deleteIndexRecurse(int, treeNode*);
+	simplexTree(condensedDistMatrix&&);
+	simplexTree(double, condensedDistMatrix&&, int);
+	void printTree(unsigned);
+	void recurseInsert(unsigned, unsigned, int, double, smallSimplex);
+	smallSimplex nodeSimplex(unsigned);
+	double findWeight(smallSimplex);
+	void deleteIndexRecurse(int, unsigned);
 
 	//virtual interface functions
 	double getSize();
 	bool insertIterative(std::vector<double>&, std::vector<std::vector<double>>&);
 	void deleteIterative(int, int);
 	void insert(std::vector<double>&);
-	bool find(std::set<unsigned>);
+	void insertAll(std::vector<std::vector<double>>&);
+	bool find(smallSimplex);
 	int simplexCount();
 	int vertexCount();
 	std::vector<std::vector<unsigned>> getDimEdges(int,double);
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> getAllEdges(double);
-	bool deletion(std::set<unsigned>);
-	bool deletion(treeNode*);
+	std::vector<std::vector<std::pair<smallSimplex, double>>> getAllEdges(double);
+	bool deletion(smallSimplex);
+	bool deleteBranch(unsigned);
 	void expandDimensions(int){return;};
 	void reduceComplex();
 	std::vector<std::pair<double, std::vector<unsigned>>> getd0Pairs();
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <typeinfo>
 #include <thread>
+#include <functional>
 #include "readInput.hpp"
 #include "argParser.hpp"
 #include "basePipe.hpp"
@@ -229,6 +230,52 @@ void processUpscaleWrapper(std::map<std::string, std::string> args, pipePacket*
 	return;*/
 }	
 
+// Load a precomputed distance matrix / weighted edge list straight into the complex
+//		Records every distance under epsilon as a filtration weight (as distMatrixPipe would)
+bool loadPrecomputedDistances(std::map<std::string, std::string> args, pipePacket* wD, readInput* rs){
+	double maxEpsilon = std::atof(args["epsilon"].c_str());
+	std::vector<double> allWeights;
+	
+	if(args["inputFormat"] == "distmatrix"){
+		auto distMatrix = rs->readDistMatrix(args["inputFile"]);
+		if(distMatrix.empty())
+			return false;
+		
+		condensedDistMatrix::valueStorage precision = condensedDistMatrix::storeDouble;
+		condensedDistMatrix::parseStorage(args["precision"], precision);
+		distMatrix.compact(precision, maxEpsilon);
+		
+		for(size_t e = 0; e < distMatrix.entryCount(); e++)
+			if(distMatrix.entry(e) < maxEpsilon)
+				allWeights.push_back(distMatrix.entry(e));
+		
+		wD->complex->setDistanceMatrix(std::move(distMatrix));
+	} else {
+		auto graph = rs->readEdgeList(args["inputFile"]);
+		if(graph.empty())
+			return false;
+		
+		for(unsigned i = 0; i < graph.size(); i++){
+			auto w = graph.weightsBegin(i);
+			for(auto it = graph.neighborsBegin(i); it != graph.neighborsEnd(i); ++it, ++w)
+				if(*it < i && *w < maxEpsilon)
+					allWeights.push_back(*w);
+		}
+		
+		wD->complex->setNeighborGraph(std::move(graph));
+	}
+	
+	//Sorted descending the weights append at the end of the set
+	std::sort(allWeights.begin(), allWeights.end(), std::greater<double>());
+	allWeights.erase(std::unique(allWeights.begin(), allWeights.end()), allWeights.end());
+	for(auto w : allWeights)
+		wD->weights.insert(wD->weights.end(), w);
+	
+	wD->weights.insert(0.0);
+	wD->weights.insert(maxEpsilon);
+	return true;
+}
+
 int main(int argc, char* argv[]){
 	//	Steps to compute PH with preprocessing:
 	//
@@ -269,7 +316,10 @@ int main(int argc, char* argv[]){
     auto args = ap->parse(argc, argv);
     
     //Determine what pipe we will be running
-    ap->setPipeline(args);
+    if(!ap->setPipeline(args)){
+        ap->printUsage();
+        return 1;
+    }
     
     for(auto z : args)
 		std::cout << z.first << "\t" << z.second << std::endl;
@@ -277,6 +327,20 @@ int main(int argc, char* argv[]){
 	//Create a pipePacket (datatype) to store the complex and pass between engines
     auto *wD = new pipePacket(args, args["complexType"]);	//wD (workingData)
 	
+	//Precomputed distances skip the preprocessor and distance stages entirely
+	if(args["inputFormat"] == "distmatrix" || args["inputFormat"] == "edgelist"){
+		if(loadPrecomputedDistances(args, wD, rs)){
+			if(args["preprocessor"] != "")
+				std::cout << "LHF : Preprocessor ignored for inputFormat " << args["inputFormat"] << std::endl;
+			
+			runPipeline(args, wD);
+		} else {
+			ap->printUsage();
+		}
+		
+		return 0;
+	}
+	
 	if(args["pipeline"] != "slidingwindow"){
 		//Read data from inputFile CSV
 		wD->originalData = rs->readCSV(args["inputFile"]);
@@ -11,6 +11,8 @@
 #include <vector>
 #include "basePipe.hpp"
 #include "distMatrixPipe.hpp"
+#include "sparseNeighborhoodPipe.hpp"
+#include "edgeCollapsePipe.hpp"
 #include "neighGraphPipe.hpp"
 #include "ripsPipe.hpp"
 #include "upscalePipe.hpp"
@@ -19,6 +21,8 @@
 #include "optPersistencePairs.hpp"
 #include "slidingWindow.hpp"
 #include "fastPersistence.hpp"
+#include "implicitPersistence.hpp"
+#include "lockFreePersistence.hpp"
 #include "naiveWindow.hpp"
 
 basePipe* basePipe::newPipe(const std::string &pipeT, const std::string &complexType){
@@ -26,6 +30,10 @@ basePipe* basePipe::newPipe(const std::string &pipeT, const std::string &complex
 	pipeType = pipeT;
 	if(pipeType == "distMatrix"){
 		return new distMatrixPipe();
+	} else if (pipeType == "sparseNeighborhood" || pipeType == "sparse"){
+		return new sparseNeighborhoodPipe();
+	} else if (pipeType == "edgeCollapse" || pipeType == "collapse"){
+		return new edgeCollapsePipe();
 	} else if (pipeType == "neighGraph"){
 		return new neighGraphPipe();
 	} else if (pipeType == "rips"){
@@ -42,6 +50,10 @@ basePipe* basePipe::newPipe(const std::string &pipeT, const std::string &complex
 		return new slidingWindow();
 	} else if (pipeType == "fastPersistence" || pipeType == "fast"){
 		return new fastPersistence();
+	} else if (pipeType == "implicitPersistence" || pipeType == "implicit"){
+		return new implicitPersistence();
+	} else if (pipeType == "lockFreePersistence" || pipeType == "lockfree"){
+		return new lockFreePersistence();
 	} else if (pipeType == "naivewindow" || pipeType == "naive"){
 		return new naiveWindow();
 	}
@@ -14,6 +14,7 @@ class basePipe {
 	std::string pipeType = "basePipe";
 	int debug = 0;
 	std::string outputFile;
+	double minPersistence = 0;
     basePipe(){};
     basePipe* newPipe(const std::string&, const std::string&);
     pipePacket runPipeWrapper(pipePacket);
@@ -50,53 +50,23 @@ int boundaryPipe::checkFace(std::vector<unsigned> face, std::vector<unsigned> si
 }
 
 // Reduce the binary boundary matrix
-std::pair<std::vector<std::vector<unsigned>>,std::pair<int,int>> boundaryPipe::reduceBoundaryMatrix(std::vector<std::vector<unsigned>> boundaryMatrix){
+std::pair<std::vector<std::vector<unsigned>>,std::pair<int,int>> boundaryPipe::reduceBoundaryMatrix(bitMatrix boundaryMatrix){
 	std::vector<std::vector<unsigned>> ret;
 	int rank = 0;
 	
-	if(boundaryMatrix.size() <= 0)
+	if(boundaryMatrix.rows() <= 0)
 		return std::make_pair(ret,std::make_pair(0,0));
 		
-	//Step through each column and search for a 1 in that column
-	for(unsigned i = 0; i < boundaryMatrix[0].size(); i++){
-		//Step through each vector
-		for(unsigned j = 0; j < boundaryMatrix.size(); j++){
-			
-			//If the vector has a 1 in the target column
-			if(boundaryMatrix[j][i] == 1){
-				rank += 1;
-				
-				//Add the vector to our returned matrix
-				auto tempRow = boundaryMatrix[j];
-				ret.push_back(tempRow);
-					
-				//Remove our vector from the boundaryMatrix and continue processing next column
-				boundaryMatrix.erase(boundaryMatrix.begin() + j);
-				
-				//Iterate through remaining vectors and XOR with our vector
-				//j += 1;
-				while(j < boundaryMatrix.size()){
-					if(boundaryMatrix[j][i] == 1){
-						//XOR the remaining rows
-						for(unsigned d = 0; d < boundaryMatrix[0].size(); d++)
-							boundaryMatrix[j][d] = boundaryMatrix[j][d] ^ tempRow[d];
-					}
-					j += 1;
-				}		
-				for(auto a : ret){
-					if (a[i] == 1){
-						for(unsigned d = 0; d < ret.size(); d++)
-							a[d] = a[d] ^ tempRow[d];
-					}					
-				}
-			}
-		}		
-	}
+	//Step through each column and search for a 1 in that column; the vector is added to
+	//		our returned matrix and XOR'd into the remaining vectors with a 1 in that column
+	boundaryMatrix.eliminate([&](unsigned, unsigned j){
+		rank += 1;
+		ret.push_back(boundaryMatrix.denseRow(j));
+	});
 
-	if(boundaryMatrix.size() > 0){
-		for (auto a : boundaryMatrix)
-			ret.push_back(a);
-	}
+	//Remaining vectors are reduced to zero
+	for(unsigned j = rank; j < boundaryMatrix.rows(); j++)
+		ret.push_back(std::vector<unsigned>(boundaryMatrix.cols(), 0));
 	
 	return std::make_pair(ret, std::make_pair(rank, (ret[0].size() - rank)));
 }
@@ -104,28 +74,24 @@ std::pair<std::vector<std::vector<unsigned>>,std::pair<int,int>> boundaryPipe::r
 // Get the boundary matrix from the edges
 std::pair<std::vector<std::vector<unsigned>>,std::pair<int,int>> boundaryPipe::boundaryMatrix(std::vector<std::vector<unsigned>> nChain, std::vector<std::vector<unsigned>> pChain){
 	std::vector<std::vector<unsigned>> ret;
-	std::vector<std::vector<unsigned>> boundary;	
-	
-	//Create the boundary matrix from chains
-	std::vector<unsigned> bDim;
 	
 	//std::cout << "pre: " << nChain.size() << " " << pChain.size() << std::endl;
 	
 	if (nChain.size() == 0)
 		return std::make_pair(ret,std::make_pair(0,pChain.size()));
 	
-	//
+	//Create the boundary matrix from chains, one bit per entry
+	bitMatrix boundary(nChain.size(), pChain.size());
 	for(unsigned i = 0; i < nChain.size(); i++){
-		std::vector<unsigned> bDim;
 		
 		//Create the columns (pChain)
 		for(unsigned j = 0; j < pChain.size(); j++){
-			bDim.push_back(checkFace(nChain[i], pChain[j]));
+			if(checkFace(nChain[i], pChain[j]))
+				boundary.set(i, j);
 		}
-		boundary.push_back(bDim);
 	}	
 
-	auto a = reduceBoundaryMatrix(boundary);
+	auto a = reduceBoundaryMatrix(std::move(boundary));
 	
 	
 	
@@ -208,7 +174,7 @@ pipePacket boundaryPipe::runPipe(pipePacket inData){
 	std::vector<int> bettiNumbers;
 	std::vector<float> lifeSpans[dim];
 	
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> edges;
+	std::vector<std::vector<std::pair<smallSimplex, double>>> edges;
 	
 	//Retrieve
 	auto local_weights = inData.weights;
@@ -365,6 +331,13 @@ bool boundaryPipe::configPipe(std::map<std::string, std::string> configMap){
 		maxEpsilon = std::atof(configMap["epsilon"].c_str());
 	else return false;
 	
+	//Z2 boundaries only (see fastPersistence for Z/p)
+	pipe = configMap.find("coeff");
+	if(pipe != configMap.end() && std::atoi(configMap["coeff"].c_str()) != 2){
+		ut.writeError("boundary","coeff " + configMap["coeff"] + " is only supported by fastPersistence");
+		return false;
+	}
+	
 	configured = true;
 	ut.writeDebug("boundary","Configured with parameters { dim: " + configMap["dimensions"] + ", eps: " + configMap["epsilon"] + ", debug: " + strDebug + ", outputFile: " + outputFile + " }");
 	
@@ -4,6 +4,7 @@
 #include <map>
 #include "basePipe.hpp"
 #include "utils.hpp"
+#include "bitMatrix.hpp"
 
 class boundaryPipe : public basePipe {
   private:
@@ -20,7 +21,7 @@ class boundaryPipe : public basePipe {
 	std::vector<std::vector<unsigned>> extractBoundaries(std::vector<std::vector<unsigned>>, std::vector<std::vector<unsigned>>, int);
 	int checkFace(std::vector<unsigned> face, std::vector<unsigned>);
 	void outputData(pipePacket);
-	std::pair<std::vector<std::vector<unsigned>>,std::pair<int,int>> reduceBoundaryMatrix(std::vector<std::vector<unsigned>>);
+	std::pair<std::vector<std::vector<unsigned>>,std::pair<int,int>> reduceBoundaryMatrix(bitMatrix);
 	std::pair<std::vector<std::vector<unsigned>>,std::pair<int,int>> boundaryMatrix(std::vector<std::vector<unsigned>>, std::vector<std::vector<unsigned>>);
 };
 
@@ -14,9 +14,18 @@
 #include <numeric>
 #include <functional>
 #include <set>
-#include <algorithm>
+#include <utility>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <sys/stat.h>
 #include "distMatrixPipe.hpp"
 #include "utils.hpp"
+#include "distanceMetrics.hpp"
+#include "filtrationValue.hpp"
 
 // basePipe constructor
 distMatrixPipe::distMatrixPipe(){
@@ -24,38 +33,160 @@ distMatrixPipe::distMatrixPipe(){
 	return;
 }
 
+// Points per tile edge; a tile of points stays cache resident while every
+//	column of the current block is computed against it
+#define DIST_TILE 64
+
+// cacheFile -> cache file name for the input data, metric and epsilon
+//		FNV-1a hash of the points (after preprocessing) and the parameters
+std::string distMatrixPipe::cacheFile(pipePacket& inData){
+	uint64_t hash = 14695981039346656037ULL;
+	auto hashBytes = [&](const void* bytes, size_t length){
+		for(size_t b = 0; b < length; b++){
+			hash ^= ((const unsigned char*)bytes)[b];
+			hash *= 1099511628211ULL;
+		}
+	};
+	
+	for(auto &row : inData.originalData){
+		uint64_t d = row.size();
+		hashBytes(&d, sizeof(d));
+		hashBytes(row.data(), row.size() * sizeof(double));
+	}
+	hashBytes(metric.data(), metric.size());
+	hashBytes(&maxEpsilon, sizeof(maxEpsilon));
+	hashBytes(&precision, sizeof(precision));
+	
+	//Single and double precision builds round the stored values differently
+	uint64_t filtrationBytes = sizeof(filtrationValue);
+	hashBytes(&filtrationBytes, sizeof(filtrationBytes));
+	
+	char name[40];
+	std::snprintf(name, sizeof(name), "distMatrix_%016llx.bin", (unsigned long long)hash);
+	return cacheDir + "/" + name;
+}
+
 // runPipe -> Run the configured functions of this pipeline segment
 pipePacket distMatrixPipe::runPipe(pipePacket inData){
-	utils ut;
+	unsigned n = inData.originalData.size();
 	
-	//Store our distance matrix
-	std::vector<std::vector<double>> distMatrix (inData.originalData.size(), std::vector<double>(inData.originalData.size(),0));
+	//Reuse a cached matrix for this input; the mapping pages in on first access
+	std::string cachePath = cacheDir.empty() ? "" : cacheFile(inData);
+	if(!cachePath.empty()){
+		condensedDistMatrix cached;
+		std::vector<double> cachedWeights;
+		
+		if(cached.load(cachePath, cachedWeights) && cached.size() == n){
+			//Mapped entries are rounded by compact, the weights here
+			bool single = (precision == condensedDistMatrix::storeFloat);
+			for(auto w : cachedWeights)
+				inData.weights.insert(inData.weights.end(), roundFiltration(w, single));
+			
+			ut.writeDebug("distMatrix", "\tLoaded cached Dist Matrix: " + cachePath);
+			cached.compact(precision, maxEpsilon);
+			
+			inData.complex->setDistanceMatrix(std::move(cached));
+			inData.weights.insert(0.0);
+			inData.weights.insert(maxEpsilon);
+			return inData;
+		}
+	}
+	
+	//Store our distance matrix (condensed upper triangle)
+	condensedDistMatrix distMatrix(n);
+	
+	//Copy the points into a contiguous row-major buffer (short rows are zero padded)
+	unsigned d = 0;
+	for(auto &row : inData.originalData)
+		d = std::max(d, (unsigned)row.size());
+	
+	std::vector<double> points((size_t)n * d, 0.0);
+	for(unsigned i = 0; i < n; i++)
+		std::copy(inData.originalData[i].begin(), inData.originalData[i].end(), points.begin() + (size_t)i * d);
 	
-	//Iterate through each vector
-	for(unsigned i = 0; i < inData.originalData.size(); i++){
-		if(!inData.originalData[i].empty()){
+	//Column blocks are claimed largest first so threads finish together
+	unsigned blockCount = (n + DIST_TILE - 1) / DIST_TILE;
+	std::atomic<unsigned> nextBlock(0);
+	std::vector<std::vector<double>> threadWeights(threads);
+	
+	//Resolve the metric and dimension once; the tile loop below is instantiated per metric
+	auto worker = dispatchMetric(metric, d, [&](auto m, auto dim){
+		using metricT = decltype(m);
+		constexpr unsigned D = decltype(dim)::value;
 		
-			//Grab a second vector to compare to 
-			std::vector<double> temp;
-			for(unsigned j = i+1; j < inData.originalData.size(); j++){
-
-					//Calculate vector distance 
-					auto dist = ut.vectors_distance(inData.originalData[i],inData.originalData[j]);
-					
-					if(dist < maxEpsilon)
-						inData.weights.insert(dist);
-					distMatrix[i][j] = dist;
+		//Squared norms for metrics formed from the dot product (||x||^2 + ||y||^2 - 2x.y)
+		bool single = (precision == condensedDistMatrix::storeFloat);
+		std::vector<double> norms(metricT::gram ? n : 0);
+		for(unsigned i = 0; i < norms.size(); i++)
+			norms[i] = metricKernels<D>::dot(&points[(size_t)i * d], &points[(size_t)i * d], d);
+		
+		return std::function<void(unsigned)>([&, norms, single](unsigned tid){
+			auto &localWeights = threadWeights[tid];
+			
+			for(unsigned b = nextBlock++; b < blockCount; b = nextBlock++){
+				unsigned j0 = (blockCount - 1 - b) * DIST_TILE;
+				unsigned j1 = std::min(j0 + DIST_TILE, n);
+				
+				//Tile over the rows above the block
+				for(unsigned i0 = 0; i0 < j1; i0 += DIST_TILE){
+					for(unsigned j = std::max(j0, i0 + 1); j < j1; j++){
+						double* col = distMatrix.column(j);
+						const double* y = &points[(size_t)j * d];
+						unsigned iEnd = std::min(i0 + DIST_TILE, j);
+						
+						//Empty points are at distance 0 from everything (as in utils::vectors_distance)
+						if(inData.originalData[j].empty())
+							continue;
+						
+						for(unsigned i = i0; i < iEnd; i++){
+							if(inData.originalData[i].empty())
+								continue;
+							
+							const double* x = &points[(size_t)i * d];
+							double dist = metricT::gram ? metricT::fromGram(metricKernels<D>::dot(x, y, d), norms[i], norms[j]) : metricT::template eval<D>(x, y, d);
+							dist = roundFiltration(dist, single);
+							
+							col[i] = dist;
+							if(dist < maxEpsilon)
+								localWeights.push_back(dist);
+						}
+					}
+				}
 			}
-		}
+		});
+	});
+	
+	std::vector<std::thread> workers;
+	for(unsigned t = 1; t < threads; t++)
+		workers.push_back(std::thread(worker, t));
+	worker(0);
+	for(auto &w : workers)
+		w.join();
+	
+	//Merge the per-thread weights; sorted descending they append at the end of the set
+	std::vector<double> allWeights;
+	for(auto &w : threadWeights){
+		allWeights.insert(allWeights.end(), w.begin(), w.end());
+		std::vector<double>().swap(w);
 	}
+	std::sort(allWeights.begin(), allWeights.end(), std::greater<double>());
+	allWeights.erase(std::unique(allWeights.begin(), allWeights.end()), allWeights.end());
+	for(auto w : allWeights)
+		inData.weights.insert(inData.weights.end(), w);
+	
+	//Store for later runs on the same input; failure only costs the recompute next time
+	if(!cachePath.empty() && !distMatrix.save(cachePath, allWeights))
+		ut.writeLog("distMatrix", "\tFailed to write distance matrix cache: " + cachePath);
+	
+	//Shrink the stored entries (float / rank) now the weights are collected
+	distMatrix.compact(precision, maxEpsilon);
+	
+	ut.writeDebug("distMatrix", "\tDist Matrix Size: " + std::to_string(distMatrix.size()) + " x " + std::to_string(distMatrix.size()) + ", metric: " + metric + ", threads: " + std::to_string(threads) + ", storage: " + std::to_string(distMatrix.getSize()) + " bytes");
 	
-	inData.complex->setDistanceMatrix(distMatrix);
+	inData.complex->setDistanceMatrix(std::move(distMatrix));
 	
 	inData.weights.insert(0.0);
 	inData.weights.insert(maxEpsilon);
-	//std::sort(inData.weights.begin(), inData.weights.end(), std::greater<>());
-	
-	ut.writeDebug("distMatrix", "\tDist Matrix Size: " + std::to_string(distMatrix.size()) + " x " + std::to_string(distMatrix.size()));
 	return inData;
 }
 
@@ -80,8 +211,41 @@ bool distMatrixPipe::configPipe(std::map<std::string, std::string> configMap){
 		maxEpsilon = std::atof(configMap["epsilon"].c_str());
 	else return false;
 	
+	pipe = configMap.find("metric");
+	if(pipe != configMap.end())
+		metric = configMap["metric"];
+	if(!validMetric(metric)){
+		ut.writeError("distMatrixPipe", "Unknown metric: " + metric);
+		return false;
+	}
+	
+	pipe = configMap.find("threads");
+	if(pipe != configMap.end())
+		threads = std::max(1, std::atoi(configMap["threads"].c_str()));
+	
+	pipe = configMap.find("precision");
+	if(pipe != configMap.end() && !condensedDistMatrix::parseStorage(configMap["precision"], precision)){
+		ut.writeError("distMatrixPipe", "Unknown precision: " + configMap["precision"]);
+		return false;
+	}
+	
+	pipe = configMap.find("cacheDir");
+	if(pipe != configMap.end() && !configMap["cacheDir"].empty()){
+		cacheDir = configMap["cacheDir"];
+		
+		//An existing directory is fine; anything else runs without the cache
+		struct stat info;
+		if(mkdir(cacheDir.c_str(), 0755) != 0){
+			int err = errno;
+			if(err != EEXIST || stat(cacheDir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)){
+				ut.writeError("distMatrixPipe", "Cannot create cacheDir " + cacheDir + ": " + std::strerror(err != EEXIST ? err : ENOTDIR) + ", caching disabled");
+				cacheDir = "";
+			}
+		}
+	}
+	
 	configured = true;
-	ut.writeDebug("distMatrixPipe","Configured with parameters { eps: " + configMap["epsilon"] + " , debug: " + strDebug + ", outputFile: " + outputFile + " }");
+	ut.writeDebug("distMatrixPipe","Configured with parameters { eps: " + configMap["epsilon"] + ", metric: " + metric + ", threads: " + std::to_string(threads) + ", cacheDir: " + cacheDir + " , debug: " + strDebug + ", outputFile: " + outputFile + " }");
 	
 	return true;
 }
@@ -91,9 +255,11 @@ void distMatrixPipe::outputData(pipePacket inData){
 	std::ofstream file;
 	file.open("output/" + pipeType + "_output.csv");
 	
-	for(auto a : inData.complex->distMatrix){
-		for(auto d : a){
-			file << d << ",";
+	//Write the upper triangle, zeros below the diagonal
+	auto &distMatrix = inData.complex->distMatrix;
+	for(unsigned i = 0; i < distMatrix.size(); i++){
+		for(unsigned j = 0; j < distMatrix.size(); j++){
+			file << (j > i ? distMatrix(i, j) : 0) << ",";
 		}
 		file << "\n";
 	}
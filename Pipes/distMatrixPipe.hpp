@@ -7,6 +7,11 @@
 class distMatrixPipe : public basePipe {
   private:
 	double maxEpsilon;
+	unsigned threads = 1;
+	std::string metric = "euclidean";
+	condensedDistMatrix::valueStorage precision = condensedDistMatrix::storeDouble;
+	std::string cacheDir = "";
+	std::string cacheFile(pipePacket&);
   public:
     distMatrixPipe();
     pipePacket runPipe(pipePacket inData);
@@ -0,0 +1,115 @@
+/*
+ * edgeCollapsePipe hpp + cpp extend the basePipe class for reducing the
+ * neighborhood graph by filtration preserving edge collapses before the
+ * complex is built; the kept edges (with their collapsed filtration values)
+ * replace the distances of the complex as a sparse neighborhood graph, so
+ * only the reduced graph is expanded and the persistence is unchanged
+ * 
+ */
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "edgeCollapsePipe.hpp"
+#include "edgeCollapse.hpp"
+#include "utils.hpp"
+
+// basePipe constructor
+edgeCollapsePipe::edgeCollapsePipe(){
+	pipeType = "edgeCollapse";
+	return;
+}
+
+// runPipe -> Run the configured functions of this pipeline segment
+pipePacket edgeCollapsePipe::runPipe(pipePacket inData){
+	auto complex = inData.complex;
+	unsigned n = std::max(complex->distMatrix.size(), complex->neighborGraph.size());
+	if(n == 0)
+		return inData;
+	
+	//Edges of the epsilon-neighborhood graph, from the sparse graph if one was built
+	std::vector<filteredEdge> edges;
+	if(!complex->neighborGraph.empty()){
+		auto &graph = complex->neighborGraph;
+		for(unsigned i = 0; i < graph.size(); i++){
+			auto w = graph.weightsBegin(i);
+			for(auto j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++, w++){
+				if(*j > i && *w <= maxEpsilon)
+					edges.push_back(filteredEdge{i, *j, *w});
+			}
+		}
+	} else {
+		for(unsigned j = 1; j < n; j++){
+			for(unsigned i = 0; i < j; i++){
+				double dist = complex->distMatrix(i, j);
+				if(dist <= maxEpsilon)
+					edges.push_back(filteredEdge{i, j, dist});
+			}
+		}
+	}
+	
+	size_t original = edges.size();
+	edges = collapseEdges(n, std::move(edges));
+	
+	std::vector<std::vector<std::pair<unsigned, double>>> adjacency(n);
+	for(auto &e : edges){
+		adjacency[e.u].push_back(std::make_pair(e.v, e.weight));
+		adjacency[e.v].push_back(std::make_pair(e.u, e.weight));
+	}
+	
+	ut.writeDebug("edgeCollapse", "\tCollapsed " + std::to_string(original) + " edges to " + std::to_string(edges.size()));
+	
+	complex->setNeighborGraph(sparseNeighborGraph(adjacency));
+	
+	return inData;
+}
+
+
+// configPipe -> configure the function settings of this pipeline segment
+bool edgeCollapsePipe::configPipe(std::map<std::string, std::string> configMap){
+	std::string strDebug;
+	
+	auto pipe = configMap.find("debug");
+	if(pipe != configMap.end()){
+		debug = std::atoi(configMap["debug"].c_str());
+		strDebug = configMap["debug"];
+	}
+	pipe = configMap.find("outputFile");
+	if(pipe != configMap.end())
+		outputFile = configMap["outputFile"].c_str();
+	
+	ut = utils(strDebug, outputFile);
+	
+	pipe = configMap.find("epsilon");
+	if(pipe != configMap.end())
+		maxEpsilon = std::atof(configMap["epsilon"].c_str());
+	else return false;
+	
+	configured = true;
+	ut.writeDebug("edgeCollapsePipe","Configured with parameters { eps: " + configMap["epsilon"] + " , debug: " + strDebug + ", outputFile: " + outputFile + " }");
+	
+	return true;
+}
+
+// outputData -> used for tracking each stage of the pipeline's data output without runtime
+void edgeCollapsePipe::outputData(pipePacket inData){
+	std::ofstream file;
+	file.open("output/" + pipeType + "_output.csv");
+	
+	//Write each kept edge once (i < j) as i,j,filtration value
+	auto &graph = inData.complex->neighborGraph;
+	for(unsigned i = 0; i < graph.size(); i++){
+		auto w = graph.weightsBegin(i);
+		for(auto j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++, w++){
+			if(*j > i)
+				file << i << "," << *j << "," << *w << "\n";
+		}
+	}
+	
+	file.close();
+	return;
+}
+
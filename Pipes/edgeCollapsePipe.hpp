@@ -0,0 +1,16 @@
+#pragma once
+
+// Header file for edgeCollapsePipe class - see edgeCollapsePipe.cpp for descriptions
+#include <map>
+#include "basePipe.hpp"
+
+class edgeCollapsePipe : public basePipe {
+  private:
+	double maxEpsilon;
+  public:
+    edgeCollapsePipe();
+    pipePacket runPipe(pipePacket inData);
+    bool configPipe(std::map<std::string, std::string> configMap);
+	void outputData(pipePacket);
+};
+
@@ -18,6 +18,10 @@
 #include <algorithm>
 #include <set>
 #include "fastPersistence.hpp"
+#include "simplexHash.hpp"
+#include "unionFind.hpp"
+#include "twistReduction.hpp"
+#include "pivotColumn.hpp"
 
 
 // basePipe constructor
@@ -38,7 +42,7 @@ pipePacket fastPersistence::runPipe(pipePacket inData){
 	std::string bettis = "";
 	
 	//Get all edges for the simplexArrayList or simplexTree
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> edges = inData.complex->getAllEdges(maxEpsilon);
+	std::vector<std::vector<std::pair<smallSimplex, double>>> edges = inData.complex->getAllEdges(maxEpsilon);
 	
 	if(edges.size() == 0)
 		return inData;
@@ -61,97 +65,57 @@ pipePacket fastPersistence::runPipe(pipePacket inData){
 	auto startTime = std::chrono::high_resolution_clock::now();
 	
 	//Get all dim 0 persistence intervals
-	//Kruskal's minimum spanning tree algorithm
-	//		Track the current connected sets (conSet)
-	//		Check edges; if contained in current set ignore
-	//			if joins into a single set, insert to set
-	//			if joins multiple sets, join all sets
-	//		Until all edges evaluated or MST found (size - 1)	
-	
-	//std::vector<std::pair<std::set<unsigned>,double>> mst;			//Store the minimum spanning tree
-	std::vector<double> mst;										//Store the minimum spanning tree (weight only)
-	std::vector<std::set<unsigned>> conSet;										//Store the connected set
-	
-	std::set<unsigned> wset;										//Store the intersection
-	std::set<unsigned> tempset;
+	//	Union-find over the sorted edges (Kruskal's minimum spanning tree); each edge
+	//	joining two components closes the younger one (elder rule) and is a pivot
+	//	of the edge boundary matrix, cleared from the dimension 1 rows
 	std::list<unsigned> pivots;										//Store identified pivots
-	unsigned pivotIndex = 0;
-		
-	//For each edge set 
-	for(auto edge : edges[1]){		
-		bool foundPivot = false;
-		bool br = false;
-		std::vector<std::set<unsigned>> conSetTemp;										//Store the connected set
-		//Check if the current set intersects with any existing connected sets
-		for(std::set<unsigned> cSet : conSet){
-			wset = ut.setIntersect(edge.first, cSet, false);
-			
-			//If one element intersects with a set and we haven't found a pivot...
-			if(!foundPivot && wset.size() == 1){
-				foundPivot = true;
-				pivots.push_back(pivotIndex);
-				mst.push_back(edge.second);
-				bettiBoundaryTableEntry des = { 0, 0, edge.second, wset };
-				inData.bettiTable.push_back(des);
-				
-				set_union(edge.first.begin(), edge.first.end(), cSet.begin(), cSet.end(), std::inserter(tempset, tempset.end()));
-				
-			//If one element intersects with a set (and we already found a pivot, join sets)
-			} else if (wset.size() == 1){
-				//Keep updating our wset with a joint set
-				//wset = ut.symmetricDiff(edge.first, cSet, false);
-				//auto ts = ut.symmetricDiff(edge.first, cSet, false);
-				//std::copy(ts.begin(), ts.end(), std::inserter(tempset, tempset.end()));
-				set_union(tempset.begin(), tempset.end(), cSet.begin(), cSet.end(), std::inserter(tempset, tempset.end()));
-				set_union(edge.first.begin(), edge.first.end(), tempset.begin(), tempset.end(), std::inserter(tempset, tempset.end()));
-			//Otherwise write the set back to the connected set
-			// Either both elements are already contained in an existing set
-			// 
-			} else if (wset.size() == 2){
-				
-				conSetTemp.push_back(cSet);
-				br = true;
-			} else {
-				conSetTemp.push_back(cSet);
-			}
-				
-		}
-		
-		//If we found our pivot we need to push back the joined set
-		if(foundPivot){
-			conSetTemp.push_back(tempset);
-			
-		//If we didn't find a pivot, and the edge wasn't contained in an existing set
-		}else if (!br){
-			conSetTemp.push_back(edge.first);
-			pivots.push_back(pivotIndex);
-			mst.push_back(edge.second);
-			
-		}
-		
-		//Check if we've filled our MST and can break...
-		if(mst.size() == edges[0].size()-1){
-			break;
-		}
-		pivotIndex++;
+	
+	for(auto merge : zeroPersistence(edges[0], edges[1])){
+		pivots.push_back(merge.edge);
+		if(merge.death - merge.birth < minPersistence)
+			continue;
 		
-		conSet = conSetTemp;
-		tempset.clear();
+		bettis += "0,0," + std::to_string(merge.death) + "\n";
+		bettiBoundaryTableEntry des = { 0, merge.birth, merge.death, {merge.u, merge.v} };
+		inData.bettiTable.push_back(des);
 	}
 	
-	for(auto z : mst){
-		bettis += "0,0," + std::to_string(z) + "\n";
-		
+	if(maxEpsilon >= minPersistence){
+		bettis += "0,0," + std::to_string(maxEpsilon) + "\n";
+		bettiBoundaryTableEntry des = { 0, 0, maxEpsilon, {} };
+		inData.bettiTable.push_back(des);
 	}
-	bettis += "0,0," + std::to_string(maxEpsilon) + "\n";
-	bettiBoundaryTableEntry des = { 0, 0, maxEpsilon, {} };
-	inData.bettiTable.push_back(des);
 	
 	
 	
 	//For higher dimensional persistence intervals
 	//	
-	if(dim > 0){
+	if(dim > 0 && (twist == "true" || field.characteristic() != 2)){
+		//Twist: reduce the boundary matrices from the top dimension down; columns of
+		//		simplices that are pivots one dimension up are cleared without reduction
+		//		(also used for coefficients other than Z2). Same pairs as below; the merge
+		//		edge rows are left out of the triangle boundaries in both.
+		std::vector<bool> merged(edges[1].size(), false);
+		for(auto p : pivots)
+			merged[p] = true;
+		auto reduced = twistReduce(edges, dim, 2, true, field, columnType, threads, merged);
+		
+		for(unsigned d = 1; d < dim && d + 1 < reduced.low.size(); d++){
+			for(unsigned j = 0; j < edges[d+1].size(); j++){
+				unsigned pIndex = reduced.low[d+1][j];
+				if(pIndex != noSimplex && edges[d][pIndex].second != edges[d+1][j].second && edges[d+1][j].second - edges[d][pIndex].second >= minPersistence){
+					bettis += std::to_string(d) + "," + std::to_string(edges[d][pIndex].second) +"," + std::to_string(edges[d+1][j].second) + "\n";
+					
+					auto& column = reduced.columns[d+1][j];
+					bettiBoundaryTableEntry des = { d, edges[d][pIndex].second, edges[d+1][j].second, std::set<unsigned>(column.begin(), column.end()) };
+					inData.bettiTable.push_back(des);
+				}
+			}
+		}
+		
+		ut.writeDebug("fastPersistence","Twist reduction over Z/" + std::to_string(field.characteristic()) + ": " + std::to_string(reduced.additions) + " column additions, " + std::to_string(reduced.cleared) + " columns cleared");
+		
+	} else if(dim > 0){
 		//Build next dimension of ordered simplices, ignoring previous dimension pivots
 		
 		//Represent the ordered simplices as indexed sets; similar to the approach in indSimplexTree
@@ -163,89 +127,69 @@ pipePacket fastPersistence::runPipe(pipePacket inData){
 		//		boundary simplices; we may not track this currently but will eventually
 		
 		
+		//Columns are reduced by their largest (youngest) row, as in the twist reduction
+		unsigned long long additions = 0;
 		for(unsigned d = 1; d < dim && d < edges.size()-1; d++){
 			
-			//Track the current pivots located into an unordered map
-			std::unordered_map<unsigned, std::set<unsigned>> v;
-			//std::cout << "D" << d << ": " << std::endl;
+			unsigned nRows = edges[d].size();
 			
-			//std::cout << "\tEdges[d]: " << edges[d].size() << "\tEdges[d+1]: " << edges[d+1].size() << std::endl;
+			//Rows cleared as pivots of the previous dimension
+			std::vector<bool> cleared(nRows, false);
+			for(auto p : pivots)
+				cleared[p] = true;
 			
-			//std::cout << "Pivots: " << pivots.size() << std::endl;
-			/*for(auto z : pivots){
-				std::cout << z << "\t";
+			//Row (index into edges[d]) of each face of each column, keyed by face lookup
+			auto rows = boundaryRows(edges[d], edges[d+1]);
+			unsigned stride = d + 2;
+			
+			// Each face row is one of:
+			//		-The pivot of the column, closing an interval
+			//		-Not a pivot, needing to be XOR with the stored pivot column
+			//		-Cleared from the previous dimension
+			std::vector<std::vector<unsigned>> v(edges[d+1].size());
+			for(unsigned columnIndex = 0; columnIndex < edges[d+1].size(); columnIndex++){
+				auto& cofaceList = v[columnIndex];
+				
+				if(!rows.empty()){
+					for(unsigned k = 0; k < stride; k++){
+						unsigned row = rows[columnIndex * stride + k];
+						if(row != noSimplex && !cleared[row])
+							cofaceList.push_back(row);
+					}
+					std::sort(cofaceList.begin(), cofaceList.end());
+				} else {
+					//Keys would overflow; check each row for intersection
+					auto& column_to_reduce = edges[d+1][columnIndex].first;
+					for(unsigned row = 0; row < nRows; row++){
+						if(!cleared[row] && std::includes(column_to_reduce.begin(), column_to_reduce.end(), edges[d][row].first.begin(), edges[d][row].first.end()))
+							cofaceList.push_back(row);
+					}
+				}
 			}
-			std::cout << std::endl;*/
 			
-			std::list<unsigned> nextPivots;
-			unsigned columnIndex = 0;
+			//Reduce the columns (in chunks over the threads), then read off the pivots
+			auto low = reduceColumns(v, nRows, {}, additions, columnType, threads);
 			
-			//Iterate the columns of the boundary matrix (i.e. the nextEdges)
-			for(auto column_to_reduce : edges[d+1]){
-				pivotIndex = 0;
-				int foundCol = 0;
-				int foundPiv = 0;
-				bool foundPivot = false;
-				bool needReduced = false;
-				std::set<unsigned> cofaceList;
-				
-				auto pivotPointer = pivots.begin();
+			std::list<unsigned> nextPivots;
+			for(unsigned columnIndex = 0; columnIndex < v.size(); columnIndex++){
+				if(low[columnIndex] == noSimplex)
+					continue;
+				nextPivots.push_back(columnIndex);
 				
-				//Begin checking each vector from lowest weight for a pivot; skip previous pivots
-				//	We want to build the vector before attempting to reduce/store
-				for(auto row_to_check : edges[d]){
-					// 1 of 3 things can happen here:
-					//		-The row is a pivot of the column, closing an interval
-					//		-The row is not a pivot, needing to be XOR with the stored pivot
-					//		-The row does not intersect (0 or cleared from previous dimension)
-					if(*pivotPointer != pivotIndex){
-						
-						//Check for intersection
-						bool isCoface = std::includes(column_to_reduce.first.begin(), column_to_reduce.first.end(), row_to_check.first.begin(), row_to_check.first.end());
-						
-						if(isCoface) {
-							cofaceList.insert(pivotIndex);
-						}
-					} else {
-						pivotPointer++;
-					}				
-					
-					pivotIndex++;
+				unsigned pIndex = low[columnIndex];
+				if(edges[d][pIndex].second != edges[d+1][columnIndex].second && edges[d+1][columnIndex].second - edges[d][pIndex].second >= minPersistence){
+					bettis += std::to_string(d) + "," + std::to_string(edges[d][pIndex].second) +"," + std::to_string(edges[d+1][columnIndex].second) + "\n";
 					
+					bettiBoundaryTableEntry des = { d, edges[d][pIndex].second, edges[d+1][columnIndex].second, std::set<unsigned>(v[columnIndex].begin(), v[columnIndex].end()) };
+					inData.bettiTable.push_back(des);
 				}
-				//Reduce the column or store into the unordered map
-								
-				std::set<unsigned int>::iterator pIndex;
-				while((pIndex = cofaceList.begin()) != cofaceList.end()){
-					if(v.find(*pIndex) == v.end()){
-						v[*pIndex] = cofaceList;
-						nextPivots.push_back(columnIndex);		
-						
-						if(edges[d][*pIndex].second != edges[d+1][columnIndex].second){
-								bettis += std::to_string(d) + "," + std::to_string(edges[d][*pIndex].second) +"," + std::to_string(edges[d+1][columnIndex].second) + "\n";
-								
-							bettiBoundaryTableEntry des = { d, edges[d][*pIndex].second, edges[d+1][columnIndex].second, cofaceList };
-							inData.bettiTable.push_back(des);
-						}
-											
-						break;
-					} else {
-						auto oldCofaceList = ut.setXOR(v[*pIndex],cofaceList);
-						
-						
-						if(oldCofaceList == cofaceList)
-							break;
-						cofaceList = oldCofaceList;
-					}
-				}
-				
-				columnIndex++;
-				
 			}
 			
 			pivots = nextPivots;
 		}
 		
+		ut.writeDebug("fastPersistence","Reduction: " + std::to_string(additions) + " column additions, threads: " + std::to_string(threads));
+		
 	}
 	
 	//std::cout << bettis << std::endl;
@@ -334,6 +278,27 @@ bool fastPersistence::configPipe(std::map<std::string, std::string> configMap){
 		twist = configMap["twist"];
 	else return false;
 	
+	pipe = configMap.find("columnType");
+	if(pipe != configMap.end())
+		columnType = configMap["columnType"];
+	
+	pipe = configMap.find("threads");
+	if(pipe != configMap.end())
+		threads = std::max(1, std::atoi(configMap["threads"].c_str()));
+	
+	pipe = configMap.find("minPersistence");
+	if(pipe != configMap.end())
+		minPersistence = std::atof(configMap["minPersistence"].c_str());
+	
+	pipe = configMap.find("coeff");
+	if(pipe != configMap.end()){
+		unsigned p = std::atoi(configMap["coeff"].c_str());
+		if(primeField::isPrime(p) && p <= primeField::maxCharacteristic)
+			field = primeField(p);
+		else
+			ut.writeError("fastPersistence","coeff " + configMap["coeff"] + " is not a prime up to " + std::to_string(primeField::maxCharacteristic) + ", using 2");
+	}
+	
 	pipe = configMap.find("fn");
 	if(pipe != configMap.end())
 		fnmod = configMap["fn"];
@@ -343,7 +308,7 @@ bool fastPersistence::configPipe(std::map<std::string, std::string> configMap){
 		alterPipe = true;
 		
 	configured = true;
-	ut.writeDebug("fastPersistence","Configured with parameters { dim: " + configMap["dimensions"] + ", twist: " + twist + ", complexType: " + configMap["complexType"] + ", eps: " + configMap["epsilon"]);
+	ut.writeDebug("fastPersistence","Configured with parameters { dim: " + configMap["dimensions"] + ", twist: " + twist + ", columnType: " + columnType + ", threads: " + std::to_string(threads) + ", coeff: " + std::to_string(field.characteristic()) + ", complexType: " + configMap["complexType"] + ", eps: " + configMap["epsilon"]);
 	ut.writeDebug("fastPersistence","\t\t\t\tdebug: " + strDebug + ", outputFile: " + outputFile + " }");
 	
 	return true;
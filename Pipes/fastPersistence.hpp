@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include "basePipe.hpp"
 #include "utils.hpp"
+#include "primeField.hpp"
 
 
 class fastPersistence : public basePipe {
@@ -14,13 +15,16 @@ class fastPersistence : public basePipe {
 	utils ut;
 	double maxEpsilon;
 	std::string twist;
+	std::string columnType = "vector";
+	unsigned threads = 1;
+	primeField field;
   public:
 	struct tArrayEntry_t{
 		bool marked = false;
 		int ti = -1;
 		double birth;
 		double death = -1;
-		std::set<unsigned> simplex;
+		smallSimplex simplex;
 	};
 	bool alterPipe = false;
 	
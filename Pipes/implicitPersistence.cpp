@@ -0,0 +1,487 @@
+/*
+ * implicitPersistence hpp + cpp extend the basePipe class for calculating the
+ * persistence intervals of a Rips filtration without building the complex
+ *
+ */
+
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include "implicitPersistence.hpp"
+
+
+// basePipe constructor
+implicitPersistence::implicitPersistence(){
+	pipeType = "ImplicitPersistence";
+	return;
+}
+
+// vertices -> decode the k vertices of a simplex from its combinatorial number system key
+//		The largest vertex v with C(v, k) <= index is found by binary search, then k-1, ...
+smallSimplex implicitPersistence::vertices(unsigned long long index, unsigned k) const {
+	smallSimplex ret;
+	unsigned top = n;
+	for(unsigned i = k; i >= 1; i--){
+		unsigned lo = i - 1, hi = top - 1;
+		while(lo < hi){
+			unsigned mid = lo + (hi - lo + 1) / 2;
+			if(binomials(mid, i) <= index)
+				lo = mid;
+			else
+				hi = mid - 1;
+		}
+		ret.insert(lo);
+		index -= binomials(lo, i);
+		top = lo;
+	}
+	return ret;
+}
+
+// diameter -> largest pairwise distance of a simplex (filtration value in the Rips complex)
+double implicitPersistence::diameter(const smallSimplex& simplex) const {
+	double ret = 0;
+	for(auto i = simplex.begin(); i != simplex.end(); i++)
+		for(auto j = std::next(i); j != simplex.end(); j++)
+			ret = std::max(ret, complex->distance(*i, *j));
+	return ret;
+}
+
+// forEachCofacet -> call f(cofacet) for every cofacet below maxEpsilon, in decreasing key order
+//		allCofacets == false only visits cofacets adding a vertex above the simplex (each
+//		simplex of the next dimension is then visited from exactly one facet). f returns false to stop.
+template<typename F>
+void implicitPersistence::forEachCofacet(const smallSimplex& simplex, double simplexDiameter, bool allCofacets, F f){
+	unsigned top = *simplex.rbegin();
+
+	auto visit = [&](unsigned v) -> bool {
+		if(simplex.count(v))
+			return true;
+		double d = simplexDiameter;
+		for(auto u : simplex){
+			double w = complex->distance(u, v);
+			if(w >= maxEpsilon)
+				return true;
+			d = std::max(d, w);
+		}
+		return f(diameterIndex{d, binomials.key(simplex.coface(v))});
+	};
+
+	if(!complex->neighborGraph.empty()){
+		//Candidates are the neighbours of the vertex with the fewest neighbours
+		auto& graph = complex->neighborGraph;
+		unsigned pick = top;
+		for(auto v : simplex)
+			if(graph.degree(v) < graph.degree(pick))
+				pick = v;
+
+		for(auto it = graph.neighborsEnd(pick); it != graph.neighborsBegin(pick); ){
+			--it;
+			if(!allCofacets && *it <= top)
+				break;
+			if(!visit(*it))
+				return;
+		}
+	} else {
+		for(unsigned v = n; v-- > 0; ){
+			if(!allCofacets && v <= top)
+				break;
+			if(!visit(v))
+				return;
+		}
+	}
+	return;
+}
+
+// zeroPivotCofacet -> first cofacet (largest key) with the same diameter, or none
+implicitPersistence::diameterIndex implicitPersistence::zeroPivotCofacet(const smallSimplex& simplex, double simplexDiameter){
+	diameterIndex ret = none;
+	forEachCofacet(simplex, simplexDiameter, true, [&](const diameterIndex& cofacet){
+		if(cofacet.diameter == simplexDiameter){
+			ret = cofacet;
+			return false;
+		}
+		return true;
+	});
+	return ret;
+}
+
+// zeroPivotFacet -> first facet (smallest key) with the same diameter, or none
+implicitPersistence::diameterIndex implicitPersistence::zeroPivotFacet(const smallSimplex& simplex, double simplexDiameter){
+	for(unsigned k = simplex.size(); k-- > 0; ){
+		auto facet = simplex.face(k);
+		double d = diameter(facet);
+		if(d == simplexDiameter)
+			return diameterIndex{d, binomials.key(facet)};
+	}
+	return none;
+}
+
+// zeroApparentCofacet -> cofacet forming an apparent pair with the simplex, or none
+//		The simplex is the youngest facet of its oldest cofacet; the pair has zero
+//		persistence and neither side needs a column in the reduction
+implicitPersistence::diameterIndex implicitPersistence::zeroApparentCofacet(const smallSimplex& simplex, double simplexDiameter, unsigned long long index){
+	auto cofacet = zeroPivotCofacet(simplex, simplexDiameter);
+	if(cofacet.diameter < 0)
+		return none;
+
+	auto facet = zeroPivotFacet(vertices(cofacet.index, simplex.size() + 1), cofacet.diameter);
+	if(facet.diameter >= 0 && facet.index == index)
+		return cofacet;
+	return none;
+}
+
+// zeroApparentFacet -> facet forming an apparent pair with the (k vertex) simplex, or none
+implicitPersistence::diameterIndex implicitPersistence::zeroApparentFacet(const diameterIndex& simplex, unsigned k){
+	auto facet = zeroPivotFacet(vertices(simplex.index, k), simplex.diameter);
+	if(facet.diameter < 0)
+		return none;
+
+	auto cofacet = zeroPivotCofacet(vertices(facet.index, k - 1), facet.diameter);
+	if(cofacet.diameter >= 0 && cofacet.index == simplex.index)
+		return facet;
+	return none;
+}
+
+// popPivot -> remove and return the pivot of a working coboundary
+//		Entries are Z2 coefficients; equal keys on top of the heap cancel in pairs
+implicitPersistence::diameterIndex implicitPersistence::popPivot(workingColumn& column){
+	if(column.empty())
+		return none;
+
+	auto pivot = column.top();
+	column.pop();
+	while(!column.empty() && column.top().index == pivot.index){
+		column.pop();
+		if(column.empty())
+			return none;
+		pivot = column.top();
+		column.pop();
+	}
+	return pivot;
+}
+
+// getPivot -> pivot of a working coboundary, left in the heap
+implicitPersistence::diameterIndex implicitPersistence::getPivot(workingColumn& column){
+	auto pivot = popPivot(column);
+	if(pivot.diameter >= 0)
+		column.push(pivot);
+	return pivot;
+}
+
+// addCoboundary -> add the coboundary of a (k vertex) simplex to the working column
+void implicitPersistence::addCoboundary(const diameterIndex& simplex, unsigned k, workingColumn& column, std::vector<diameterIndex>& reduction){
+	forEachCofacet(vertices(simplex.index, k), simplex.diameter, true, [&](const diameterIndex& cofacet){
+		column.push(cofacet);
+		return true;
+	});
+	reduction.push_back(simplex);
+	return;
+}
+
+// computeZeroPairs -> H0 intervals by union-find over the edges in filtration order
+//		Edges joining two components die (MST edges); the rest are returned as the
+//		dimension 1 columns, less those in a zero persistence apparent pair
+std::vector<implicitPersistence::diameterIndex> implicitPersistence::computeZeroPairs(pipePacket& inData, std::string& bettis, std::vector<diameterIndex>& edges){
+	//Edge key {i < j} is C(j, 2) + i, the condensed distance matrix index
+	//		Edges enter below maxEpsilon, as in the complexes
+	if(!complex->neighborGraph.empty()){
+		auto& graph = complex->neighborGraph;
+		for(unsigned i = 0; i < n; i++){
+			auto w = graph.weightsBegin(i);
+			for(auto j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++, w++)
+				if(*j > i && *w < maxEpsilon)
+					edges.push_back(diameterIndex{*w, binomials(*j, 2) + i});
+		}
+	} else {
+		for(unsigned j = 1; j < n; j++){
+			for(unsigned i = 0; i < j; i++){
+				double d = complex->distance(i, j);
+				if(d < maxEpsilon)
+					edges.push_back(diameterIndex{d, binomials(j, 2) + i});
+			}
+		}
+	}
+	std::sort(edges.begin(), edges.end(), filtrationOrder());
+
+	std::vector<unsigned> parent(n);
+	std::iota(parent.begin(), parent.end(), 0);
+	auto find = [&](unsigned x){
+		while(parent[x] != x){
+			parent[x] = parent[parent[x]];
+			x = parent[x];
+		}
+		return x;
+	};
+
+	std::vector<diameterIndex> columns;
+	for(auto& edge : edges){
+		auto ends = vertices(edge.index, 2);
+		unsigned u = find(*ends.begin()), v = find(*ends.rbegin());
+
+		if(u != v){
+			parent[std::max(u, v)] = std::min(u, v);
+			if(edge.diameter >= minPersistence){
+				bettis += "0,0," + std::to_string(edge.diameter) + "\n";
+				bettiBoundaryTableEntry des = { 0, 0, edge.diameter, {*ends.begin(), *ends.rbegin()} };
+				inData.bettiTable.push_back(des);
+			}
+		} else if(dim > 1 && zeroApparentCofacet(ends, edge.diameter, edge.index).diameter < 0){
+			columns.push_back(edge);
+		}
+	}
+
+	//One essential H0 interval, as in fastPersistence
+	if(maxEpsilon >= minPersistence){
+		bettis += "0,0," + std::to_string(maxEpsilon) + "\n";
+		bettiBoundaryTableEntry des = { 0, 0, maxEpsilon, {} };
+		inData.bettiTable.push_back(des);
+	}
+
+	std::sort(columns.begin(), columns.end(), [](const diameterIndex& a, const diameterIndex& b){ return filtrationOrder()(b, a); });
+	return columns;
+}
+
+// computePairs -> reduce the coboundary columns of dimension d (d + 1 vertices)
+//		Columns are visited in reverse filtration order; pivots are recorded in the
+//		pivot table (key -> column) for the next dimension's clearing
+void implicitPersistence::computePairs(std::vector<diameterIndex>& columns, unsigned d, simplexHash& pivotTable, pipePacket& inData, std::string& bettis){
+	std::vector<std::vector<diameterIndex>> reduction(columns.size());
+	pivotTable.reserve(columns.size());
+
+	for(unsigned j = 0; j < columns.size(); j++){
+		auto column = columns[j];
+		workingColumn coboundary;
+		std::vector<diameterIndex> working;
+
+		//Emergent pair: the first cofacet with the column's diameter is the pivot if no
+		//		other column claims it, so the coboundary never has to be built
+		diameterIndex pivot = none;
+		bool checkEmergent = true, emergent = false;
+		std::vector<diameterIndex> cofacets;
+		forEachCofacet(vertices(column.index, d + 1), column.diameter, true, [&](const diameterIndex& cofacet){
+			if(checkEmergent && cofacet.diameter == column.diameter){
+				if(pivotTable.find(cofacet.index) == nullptr && zeroApparentFacet(cofacet, d + 2).diameter < 0){
+					pivot = cofacet;
+					emergent = true;
+					return false;
+				}
+				checkEmergent = false;
+			}
+			cofacets.push_back(cofacet);
+			return true;
+		});
+
+		if(!emergent){
+			for(auto& cofacet : cofacets)
+				coboundary.push(cofacet);
+			pivot = getPivot(coboundary);
+		}
+
+		while(true){
+			//Zeroed column, an essential class; not reported above H0 (as in fastPersistence)
+			if(pivot.diameter < 0)
+				break;
+
+			if(!emergent){
+				auto pair = pivotTable.find(pivot.index);
+				if(pair != nullptr){
+					unsigned k = pair->position;
+					addCoboundary(columns[k], d + 1, coboundary, working);
+					for(auto& simplex : reduction[k])
+						addCoboundary(simplex, d + 1, coboundary, working);
+					pivot = getPivot(coboundary);
+					continue;
+				}
+
+				auto facet = zeroApparentFacet(pivot, d + 2);
+				if(facet.diameter >= 0){
+					addCoboundary(facet, d + 1, coboundary, working);
+					pivot = getPivot(coboundary);
+					continue;
+				}
+			}
+
+			//New pivot; keep V[j] with the Z2 duplicates cancelled
+			std::sort(working.begin(), working.end(), [](const diameterIndex& a, const diameterIndex& b){ return a.index < b.index; });
+			for(unsigned i = 0; i < working.size(); ){
+				if(i + 1 < working.size() && working[i].index == working[i+1].index)
+					i += 2;
+				else
+					reduction[j].push_back(working[i++]);
+			}
+			pivotTable.insert(pivot.index, pivot.diameter, j);
+
+			//Representative points are only collected for intervals that are kept
+			if(pivot.diameter > column.diameter && pivot.diameter - column.diameter >= minPersistence){
+				bettis += std::to_string(d) + "," + std::to_string(column.diameter) + "," + std::to_string(pivot.diameter) + "\n";
+
+				std::set<unsigned> boundaryPoints;
+				for(auto v : vertices(column.index, d + 1))
+					boundaryPoints.insert(v);
+				for(auto& simplex : reduction[j])
+					for(auto v : vertices(simplex.index, d + 1))
+						boundaryPoints.insert(v);
+
+				bettiBoundaryTableEntry des = { d, column.diameter, pivot.diameter, boundaryPoints };
+				inData.bettiTable.push_back(des);
+			}
+			break;
+		}
+	}
+
+	return;
+}
+
+// assembleColumns -> simplices (d + 2 vertices) of the next dimension and its columns
+//		Clearing: cofacets already paired as pivots of dimension d are dropped, as are
+//		simplices on either side of a zero persistence apparent pair
+std::vector<implicitPersistence::diameterIndex> implicitPersistence::assembleColumns(std::vector<diameterIndex>& simplices, unsigned d, simplexHash& pivotTable){
+	std::vector<diameterIndex> next, columns;
+
+	for(auto& simplex : simplices){
+		forEachCofacet(vertices(simplex.index, d + 1), simplex.diameter, false, [&](const diameterIndex& cofacet){
+			next.push_back(cofacet);
+			if(pivotTable.find(cofacet.index) == nullptr
+					&& zeroApparentFacet(cofacet, d + 2).diameter < 0
+					&& zeroApparentCofacet(vertices(cofacet.index, d + 2), cofacet.diameter, cofacet.index).diameter < 0)
+				columns.push_back(cofacet);
+			return true;
+		});
+	}
+
+	simplices.swap(next);
+	std::sort(columns.begin(), columns.end(), [](const diameterIndex& a, const diameterIndex& b){ return filtrationOrder()(b, a); });
+	return columns;
+}
+
+// runPipe -> Run the configured functions of this pipeline segment
+//
+//	ImplicitPersistence: For computing the persistence intervals of the Rips filtration:
+//		1. See Bauer-21 (Ripser) for algorithm/description
+//		2. Simplices are never stored; they are combinatorial number system keys whose
+//			diameters, cofacets and facets are recomputed from the distances
+//		3. H0 by union-find, H1..H(dim-1) by cohomology reduction with clearing,
+//			emergent and apparent pairs (Z2 coefficients)
+pipePacket implicitPersistence::runPipe(pipePacket inData){
+	complex = inData.complex;
+	if(complex == nullptr || !complex->hasDistances()){
+		ut.writeError("implicitPersistence", "No distance matrix or neighborhood graph; run distMatrix or sparseNeighborhood first");
+		return inData;
+	}
+	n = complex->neighborGraph.empty() ? complex->distMatrix.size() : complex->neighborGraph.size();
+	if(n == 0)
+		return inData;
+
+	//Keys of the largest simplices visited (cofacets of the top dimension) must be exact
+	unsigned maxVertices = std::max(dim + 1, 2);
+	binomials.reserve(n, maxVertices);
+	if(!binomials.fits(n, maxVertices)){
+		ut.writeError("implicitPersistence", "Simplex keys overflow for " + std::to_string(n) + " points in dimension " + std::to_string(dim));
+		return inData;
+	}
+
+	//Start a timer for physical time passed during the pipe's function
+	auto startTime = std::chrono::high_resolution_clock::now();
+
+	std::string bettis = "";
+	std::vector<diameterIndex> simplices;
+	auto columns = computeZeroPairs(inData, bettis, simplices);
+
+	for(unsigned d = 1; (int)d < dim; d++){
+		simplexHash pivotTable;
+		computePairs(columns, d, pivotTable, inData, bettis);
+
+		if((int)d + 1 < dim)
+			columns = assembleColumns(simplices, d, pivotTable);
+	}
+
+	//Stop the timer for time passed during the pipe's function
+	auto endTime = std::chrono::high_resolution_clock::now();
+
+	//Calculate the duration (physical time) for the pipe's function
+	std::chrono::duration<double, std::milli> elapsed = endTime - startTime;
+
+	//Output the time and memory used for this pipeline segment
+	ut.writeDebug("implicitPersistence", "Bettis executed in " + std::to_string(elapsed.count()/1000.0) + " seconds (physical time)");
+
+	inData.bettiOutput = bettis;
+
+	return inData;
+}
+
+
+// outputData -> used for tracking each stage of the pipeline's data output without runtime
+void implicitPersistence::outputData(pipePacket inData){
+	std::ofstream file;
+	if(fnmod.size() > 0)
+		file.open("output/"+pipeType+"_bettis_output"+fnmod+".csv");
+	else
+		file.open("output/" + pipeType + "_bettis_output.csv");
+
+	file << inData.bettiOutput;
+
+	file.close();
+
+	return;
+}
+
+
+// configPipe -> configure the function settings of this pipeline segment
+bool implicitPersistence::configPipe(std::map<std::string, std::string> configMap){
+	std::string strDebug;
+
+	auto pipe = configMap.find("debug");
+	if(pipe != configMap.end()){
+		debug = std::atoi(configMap["debug"].c_str());
+		strDebug = configMap["debug"];
+	}
+	pipe = configMap.find("outputFile");
+	if(pipe != configMap.end())
+		outputFile = configMap["outputFile"].c_str();
+
+	ut = utils(strDebug, outputFile);
+
+	pipe = configMap.find("dimensions");
+	if(pipe != configMap.end())
+		dim = std::atoi(configMap["dimensions"].c_str());
+	else return false;
+
+	pipe = configMap.find("epsilon");
+	if(pipe != configMap.end())
+		maxEpsilon = std::atof(configMap["epsilon"].c_str());
+	else return false;
+
+	pipe = configMap.find("fn");
+	if(pipe != configMap.end())
+		fnmod = configMap["fn"];
+
+	//Cofacets of the top dimension are held inline as smallSimplex
+	unsigned capacity = smallSimplex::capacity;
+	if(dim + 1 > (int)capacity){
+		ut.writeError("implicitPersistence", "dimensions " + std::to_string(dim) + " exceeds LHF_MAX_SIMPLEX_VERTICES, using " + std::to_string(capacity - 1));
+		dim = capacity - 1;
+	}
+
+	pipe = configMap.find("minPersistence");
+	if(pipe != configMap.end())
+		minPersistence = std::atof(configMap["minPersistence"].c_str());
+
+	//Z2 reduction only (see fastPersistence for Z/p)
+	pipe = configMap.find("coeff");
+	if(pipe != configMap.end() && std::atoi(configMap["coeff"].c_str()) != 2){
+		ut.writeError("implicitPersistence","coeff " + configMap["coeff"] + " is only supported by fastPersistence");
+		return false;
+	}
+
+	configured = true;
+	ut.writeDebug("implicitPersistence","Configured with parameters { dim: " + configMap["dimensions"] + ", eps: " + configMap["epsilon"]);
+	ut.writeDebug("implicitPersistence","\t\t\t\tdebug: " + strDebug + ", outputFile: " + outputFile + " }");
+
+	return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// Header file for implicitPersistence class - see implicitPersistence.cpp for descriptions
+#include <map>
+#include <queue>
+#include <vector>
+#include "basePipe.hpp"
+#include "utils.hpp"
+#include "simplexHash.hpp"
+
+class implicitPersistence : public basePipe {
+  private:
+	//Simplex of the implicit Rips filtration: diameter and combinatorial number system key
+	struct diameterIndex{
+		double diameter;
+		unsigned long long index;
+	};
+
+	//Filtration order within a dimension: diameter, then reverse key order
+	struct filtrationOrder{
+		bool operator()(const diameterIndex& a, const diameterIndex& b) const {
+			return a.diameter < b.diameter || (a.diameter == b.diameter && a.index > b.index);
+		}
+	};
+
+	//Heap of a working coboundary; the pivot (earliest cofacet in the filtration) is on top
+	struct pivotOrder{
+		bool operator()(const diameterIndex& a, const diameterIndex& b) const {
+			return filtrationOrder()(b, a);
+		}
+	};
+	typedef std::priority_queue<diameterIndex, std::vector<diameterIndex>, pivotOrder> workingColumn;
+
+	utils ut;
+	double maxEpsilon = 0;
+	int dim = 1;
+
+	simplexBase* complex = nullptr;
+	unsigned n = 0;
+	binomialTable binomials;
+
+	const diameterIndex none = {-1, 0};
+
+	smallSimplex vertices(unsigned long long, unsigned) const;
+	double diameter(const smallSimplex&) const;
+	template<typename F> void forEachCofacet(const smallSimplex&, double, bool, F);
+	diameterIndex zeroPivotCofacet(const smallSimplex&, double);
+	diameterIndex zeroPivotFacet(const smallSimplex&, double);
+	diameterIndex zeroApparentCofacet(const smallSimplex&, double, unsigned long long);
+	diameterIndex zeroApparentFacet(const diameterIndex&, unsigned);
+	diameterIndex popPivot(workingColumn&);
+	diameterIndex getPivot(workingColumn&);
+	void addCoboundary(const diameterIndex&, unsigned, workingColumn&, std::vector<diameterIndex>&);
+
+	std::vector<diameterIndex> computeZeroPairs(pipePacket&, std::string&, std::vector<diameterIndex>&);
+	void computePairs(std::vector<diameterIndex>&, unsigned, simplexHash&, pipePacket&, std::string&);
+	std::vector<diameterIndex> assembleColumns(std::vector<diameterIndex>&, unsigned, simplexHash&);
+
+  public:
+    implicitPersistence();
+    pipePacket runPipe(pipePacket inData);
+    bool configPipe(std::map<std::string, std::string> configMap);
+	void outputData(pipePacket);
+};
@@ -0,0 +1,196 @@
+/*
+ * lockFreePersistence hpp + cpp extend the basePipe class for calculating the
+ * persistence intervals of a complex with the lock-free shared memory reduction
+ *
+ */
+
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <set>
+#include "lockFreePersistence.hpp"
+#include "simplexHash.hpp"
+#include "unionFind.hpp"
+#include "twistReduction.hpp"
+#include "lockFreeReduction.hpp"
+
+
+// basePipe constructor
+lockFreePersistence::lockFreePersistence(){
+	pipeType = "LockFreePersistence";
+	return;
+}
+
+// runPipe -> Run the configured functions of this pipeline segment
+//
+//	LockFreePersistence: For computing the persistence pairs from simplicial complex:
+//		1. H0 by union-find over the sorted edges
+//		2. Boundary matrices from the top dimension down with clearing; each matrix is
+//			reduced by all threads at once against a shared atomic pivot table
+//			(see lockFreeReduction.hpp, Morozov-Nigmetov-20)
+pipePacket lockFreePersistence::runPipe(pipePacket inData){
+
+	if(dim > 0)
+		inData.complex->expandDimensions(dim + 1);
+
+	//Get all simplices, by dimension, in filtration order
+	std::vector<std::vector<std::pair<smallSimplex, double>>> edges = inData.complex->getAllEdges(maxEpsilon);
+
+	if(edges.size() < 2)
+		return inData;
+
+	//Start a timer for physical time passed during the pipe's function
+	auto startTime = std::chrono::high_resolution_clock::now();
+
+	std::string bettis = "";
+
+	//Get all dim 0 persistence intervals
+	for(auto merge : zeroPersistence(edges[0], edges[1])){
+		if(merge.death - merge.birth < minPersistence)
+			continue;
+		bettis += "0,0," + std::to_string(merge.death) + "\n";
+		bettiBoundaryTableEntry des = { 0, merge.birth, merge.death, {merge.u, merge.v} };
+		inData.bettiTable.push_back(des);
+	}
+
+	if(maxEpsilon >= minPersistence){
+		bettis += "0,0," + std::to_string(maxEpsilon) + "\n";
+		bettiBoundaryTableEntry des = { 0, 0, maxEpsilon, {} };
+		inData.bettiTable.push_back(des);
+	}
+
+	//Intervals of dimensions 1 .. dim-1, top down; pivots of dimension d+1 clear their columns in dimension d
+	unsigned top = std::min<unsigned>(std::max(dim - 1, 0), edges.size() - 2);
+	std::vector<std::string> dimBettis(top + 1);
+	std::vector<std::vector<bettiBoundaryTableEntry>> dimEntries(top + 1);
+	std::vector<bool> clear;
+	unsigned long long additions = 0, cleared = 0;
+
+	for(unsigned d = top; d >= 1; d--){
+		auto& nChain = edges[d];
+		auto& pChain = edges[d+1];
+
+		auto columns = boundaryColumns(nChain, pChain);
+		for(auto c : clear)
+			cleared += c;
+
+		auto dimStart = std::chrono::high_resolution_clock::now();
+		auto low = lockFreeReduce(columns, nChain.size(), clear, additions, columnType, threads);
+		std::chrono::duration<double, std::milli> dimElapsed = std::chrono::high_resolution_clock::now() - dimStart;
+		ut.writeDebug("lockFreePersistence","Dimension " + std::to_string(d) + ": " + std::to_string(pChain.size()) + " columns reduced in " + std::to_string(dimElapsed.count()/1000.0) + " seconds");
+
+		std::vector<bool> nextClear(nChain.size(), false);
+		for(unsigned j = 0; j < low.size(); j++){
+			if(low[j] == noSimplex)
+				continue;
+			nextClear[low[j]] = true;
+
+			if(nChain[low[j]].second != pChain[j].second && pChain[j].second - nChain[low[j]].second >= minPersistence){
+				dimBettis[d] += std::to_string(d) + "," + std::to_string(nChain[low[j]].second) + "," + std::to_string(pChain[j].second) + "\n";
+
+				bettiBoundaryTableEntry des = { d, nChain[low[j]].second, pChain[j].second, std::set<unsigned>(columns[j].begin(), columns[j].end()) };
+				dimEntries[d].push_back(des);
+			}
+		}
+		clear.swap(nextClear);
+
+		if(d == 1)
+			break;
+	}
+
+	for(unsigned d = 1; d <= top; d++){
+		bettis += dimBettis[d];
+		inData.bettiTable.insert(inData.bettiTable.end(), dimEntries[d].begin(), dimEntries[d].end());
+	}
+
+	ut.writeDebug("lockFreePersistence","Reduction: " + std::to_string(additions) + " column additions, " + std::to_string(cleared) + " columns cleared, threads: " + std::to_string(threads));
+
+	//Stop the timer for time passed during the pipe's function
+	auto endTime = std::chrono::high_resolution_clock::now();
+
+	//Calculate the duration (physical time) for the pipe's function
+	std::chrono::duration<double, std::milli> elapsed = endTime - startTime;
+
+	//Output the time and memory used for this pipeline segment
+	ut.writeDebug("lockFreePersistence","Bettis executed in " + std::to_string(elapsed.count()/1000.0) + " seconds (physical time)");
+
+	inData.bettiOutput = bettis;
+
+	return inData;
+}
+
+
+
+// outputData -> used for tracking each stage of the pipeline's data output without runtime
+void lockFreePersistence::outputData(pipePacket inData){
+	std::ofstream file;
+	if(fnmod.size() > 0)
+		file.open("output/"+pipeType+"_bettis_output"+fnmod+".csv");
+	else
+		file.open("output/" + pipeType + "_bettis_output.csv");
+
+	file << inData.bettiOutput;
+
+	file.close();
+
+	return;
+}
+
+
+// configPipe -> configure the function settings of this pipeline segment
+bool lockFreePersistence::configPipe(std::map<std::string, std::string> configMap){
+	std::string strDebug;
+
+	auto pipe = configMap.find("debug");
+	if(pipe != configMap.end()){
+		debug = std::atoi(configMap["debug"].c_str());
+		strDebug = configMap["debug"];
+	}
+	pipe = configMap.find("outputFile");
+	if(pipe != configMap.end())
+		outputFile = configMap["outputFile"].c_str();
+
+	ut = utils(strDebug, outputFile);
+
+	pipe = configMap.find("dimensions");
+	if(pipe != configMap.end())
+		dim = std::atoi(configMap["dimensions"].c_str());
+	else return false;
+
+	pipe = configMap.find("epsilon");
+	if(pipe != configMap.end())
+		maxEpsilon = std::atof(configMap["epsilon"].c_str());
+	else return false;
+
+	pipe = configMap.find("columnType");
+	if(pipe != configMap.end())
+		columnType = configMap["columnType"];
+
+	pipe = configMap.find("threads");
+	if(pipe != configMap.end())
+		threads = std::max(1, std::atoi(configMap["threads"].c_str()));
+
+	pipe = configMap.find("fn");
+	if(pipe != configMap.end())
+		fnmod = configMap["fn"];
+
+	pipe = configMap.find("minPersistence");
+	if(pipe != configMap.end())
+		minPersistence = std::atof(configMap["minPersistence"].c_str());
+
+	//Z2 reduction only (see fastPersistence for Z/p)
+	pipe = configMap.find("coeff");
+	if(pipe != configMap.end() && std::atoi(configMap["coeff"].c_str()) != 2){
+		ut.writeError("lockFreePersistence","coeff " + configMap["coeff"] + " is only supported by fastPersistence");
+		return false;
+	}
+
+	configured = true;
+	ut.writeDebug("lockFreePersistence","Configured with parameters { dim: " + configMap["dimensions"] + ", columnType: " + columnType + ", threads: " + std::to_string(threads) + ", eps: " + configMap["epsilon"]);
+	ut.writeDebug("lockFreePersistence","\t\t\t\tdebug: " + strDebug + ", outputFile: " + outputFile + " }");
+
+	return true;
+}
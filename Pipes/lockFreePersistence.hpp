@@ -0,0 +1,23 @@
+#pragma once
+
+// Header file for lockFreePersistence class - see lockFreePersistence.cpp for descriptions
+#include <map>
+#include <vector>
+#include "basePipe.hpp"
+#include "utils.hpp"
+
+
+class lockFreePersistence : public basePipe {
+  private:
+	utils ut;
+	double maxEpsilon = 0;
+	int dim = 1;
+	std::string columnType = "vector";
+	unsigned threads = 1;
+
+  public:
+    lockFreePersistence();
+    pipePacket runPipe(pipePacket inData);
+    bool configPipe(std::map<std::string, std::string> configMap);
+	void outputData(pipePacket);
+};
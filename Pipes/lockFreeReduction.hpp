@@ -0,0 +1,195 @@
+#pragma once
+
+#ifndef LOCKFREEREDUCTION_HPP_INCL
+#define LOCKFREEREDUCTION_HPP_INCL
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include "simplexHash.hpp"
+#include "pivotColumn.hpp"
+
+// Header only lock-free shared memory column reduction (see Morozov-Nigmetov-20)
+//		Worker threads take columns in filtration order and reduce them concurrently. Each
+//		column is published as an immutable version behind an atomic pointer; the pivot of
+//		every row is claimed in an atomic row -> column table by compare and swap:
+//
+//		-row unclaimed: publish the column, claim the row
+//		-claimed by an earlier column: add that column's current version (if its low is
+//			still the row, otherwise re-read the table)
+//		-claimed by a later column: publish, take the row from it, continue with the later
+//			column (which is no longer reduced)
+//
+//		Replaced versions are freed by epoch based reclamation once no thread that could
+//		have read them is still inside a column. Pairs match the sequential reduction.
+
+class epochReclaimer {
+  private:
+	typedef const std::vector<unsigned>* column;
+	static const unsigned retireBatch = 64;
+
+	std::atomic<unsigned long long> epoch;
+	std::unique_ptr<std::atomic<unsigned long long>[]> announced;		//Epoch each thread entered at, 0 if outside
+	std::vector<std::vector<std::pair<unsigned long long, column>>> retired;
+	unsigned threads;
+
+	// Free the versions retired before the oldest epoch still announced
+	void reclaim(unsigned tid){
+		unsigned long long oldest = std::numeric_limits<unsigned long long>::max();
+		for(unsigned t = 0; t < threads; t++){
+			unsigned long long e = announced[t].load();
+			if(e != 0)
+				oldest = std::min(oldest, e);
+		}
+
+		auto& list = retired[tid];
+		unsigned kept = 0;
+		for(auto& r : list){
+			if(r.first < oldest)
+				delete r.second;
+			else
+				list[kept++] = r;
+		}
+		list.resize(kept);
+	};
+
+  public:
+	epochReclaimer(unsigned threads) : epoch(1), announced(new std::atomic<unsigned long long>[threads]), retired(threads), threads(threads){
+		for(unsigned t = 0; t < threads; t++)
+			announced[t].store(0);
+	};
+
+	~epochReclaimer(){
+		for(auto& list : retired)
+			for(auto& r : list)
+				delete r.second;
+	};
+
+	void enter(unsigned tid){ announced[tid].store(epoch.load()); };
+	void exit(unsigned tid){ announced[tid].store(0); };
+
+	void retire(unsigned tid, column c){
+		retired[tid].push_back(std::make_pair(epoch.load(), c));
+		if(retired[tid].size() >= retireBatch){
+			epoch++;
+			reclaim(tid);
+		}
+	};
+};
+
+
+// Reduce columns (sorted rows < nRows) by the standard algorithm (low = largest row) on the
+//		given number of threads; columns flagged in skip are zeroed without reduction. Reduced
+//		columns are left in place, returns the low of each column (noSimplex if zero).
+template<typename Column>
+std::vector<unsigned> lockFreeReduce(std::vector<std::vector<unsigned>>& columns, unsigned nRows, const std::vector<bool>& skip, unsigned long long& additions, unsigned threads = 1){
+	typedef const std::vector<unsigned>* version;
+	unsigned n = columns.size();
+	threads = std::max<unsigned>(1, threads);
+
+	std::unique_ptr<std::atomic<version>[]> published(new std::atomic<version>[n]);
+	std::unique_ptr<std::atomic<unsigned>[]> pivotOf(new std::atomic<unsigned>[nRows]);
+	for(unsigned j = 0; j < n; j++){
+		if(j < skip.size() && skip[j])
+			columns[j].clear();
+		published[j].store(new std::vector<unsigned>(std::move(columns[j])));
+	}
+	for(unsigned i = 0; i < nRows; i++)
+		pivotOf[i].store(noSimplex);
+
+	epochReclaimer reclaimer(threads);
+	std::atomic<unsigned> nextColumn(0);
+	std::vector<unsigned long long> threadAdditions(threads, 0);
+
+	auto worker = [&](unsigned tid){
+		Column work;
+		work.init(nRows);
+
+		//Replace the published version of a column with the working column
+		auto publish = [&](unsigned j){
+			auto next = new std::vector<unsigned>();
+			work.store(*next);
+			reclaimer.retire(tid, published[j].exchange(next));
+			work.load(*next);
+		};
+
+		for(unsigned j = nextColumn++; j < n; j = nextColumn++){
+			reclaimer.enter(tid);
+
+			unsigned current = j;
+			work.load(*published[current].load());
+
+			while(true){
+				unsigned low = work.pivot();
+				if(low == noSimplex){
+					publish(current);
+					break;
+				}
+
+				unsigned pivot = pivotOf[low].load();
+				if(pivot == current)
+					break;
+
+				if(pivot == noSimplex){
+					publish(current);
+					if(pivotOf[low].compare_exchange_strong(pivot, current))
+						break;
+				} else if(pivot < current){
+					version other = published[pivot].load();
+					if(!other->empty() && other->back() == low){
+						work.add(*other);
+						threadAdditions[tid]++;
+					}
+				} else {
+					publish(current);
+					if(pivotOf[low].compare_exchange_strong(pivot, current)){
+						//The later column lost its pivot; reduce it further
+						std::vector<unsigned> scratch;
+						work.store(scratch);
+						current = pivot;
+						work.load(*published[current].load());
+					}
+				}
+			}
+
+			std::vector<unsigned> scratch;
+			work.store(scratch);
+			reclaimer.exit(tid);
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for(unsigned t = 1; t < threads; t++)
+		workers.push_back(std::thread(worker, t));
+	worker(0);
+	for(auto &w : workers)
+		w.join();
+
+	for(auto a : threadAdditions)
+		additions += a;
+
+	std::vector<unsigned> low(n, noSimplex);
+	for(unsigned j = 0; j < n; j++){
+		version v = published[j].load();
+		columns[j] = *v;
+		delete v;
+		if(!columns[j].empty())
+			low[j] = columns[j].back();
+	}
+
+	return low;
+}
+
+// Lock-free reduction with the working column representation named by columnType
+//		(vector, heap, bit_tree or full)
+inline std::vector<unsigned> lockFreeReduce(std::vector<std::vector<unsigned>>& columns, unsigned nRows, const std::vector<bool>& skip, unsigned long long& additions, const std::string& columnType, unsigned threads = 1){
+	return dispatchColumn(columnType, [&](auto column){
+		return lockFreeReduce<decltype(column)>(columns, nRows, skip, additions, threads);
+	});
+}
+
+#endif
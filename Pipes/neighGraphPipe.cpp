@@ -11,6 +11,7 @@
 #include <vector>
 #include <chrono>
 #include <functional>
+#include <algorithm>
 #include "neighGraphPipe.hpp"
 
 
@@ -23,13 +24,26 @@ neighGraphPipe::neighGraphPipe(){
 // runPipe -> Run the configured functions of this pipeline segment
 pipePacket neighGraphPipe::runPipe(pipePacket inData){	
 	
-	//Iterate through each vector, inserting into simplex storage
-	for(unsigned i = 0; i < inData.originalData.size(); i++){
-		if(!inData.originalData[i].empty()){
-			//insert data into the complex (SimplexArrayList, SimplexTree)
-			inData.complex->insert(inData.originalData[i]);	
-		}
+	//Sparse neighborhood graph: the complexes walk only the stored edges of each
+	//	inserted point instead of a full row of the distance matrix
+	if(!inData.complex->neighborGraph.empty())
+		ut.writeDebug("neighGraph", "\tBuilding from sparse neighborhood graph: " + std::to_string(inData.complex->neighborGraph.edgeCount()) + " edges");
+	
+	//The trees enumerate the simplices each point adds over the threads (see lowerStar.hpp)
+	inData.complex->threads = threads;
+	
+	//Precomputed distances (distmatrix / edgelist input) carry no coordinates,
+	//	insert each point of the loaded distances by index
+	if(inData.originalData.empty()){
+		unsigned n = std::max(inData.complex->distMatrix.size(), inData.complex->neighborGraph.size());
+		std::vector<std::vector<double>> placeholders(n, std::vector<double>(1, 0));
+		inData.complex->insertAll(placeholders);
+		
+		return inData;
 	}
+	
+	//Insert each (non-empty) vector into simplex storage (SimplexArrayList, SimplexTree)
+	inData.complex->insertAll(inData.originalData);
 
 	return inData;
 }
@@ -60,8 +74,12 @@ bool neighGraphPipe::configPipe(std::map<std::string, std::string> configMap){
 	}
 	else return false;
 	
+	pipe = configMap.find("threads");
+	if(pipe != configMap.end())
+		threads = std::max(1, std::atoi(configMap["threads"].c_str()));
+	
 	configured = true;
-	ut.writeDebug("neighGraphPipe","Configured with parameters { dim: " + std::to_string(dim) + " , eps: " + configMap["epsilon"] + " , debug: " + strDebug + ", outputFile: " + outputFile + " }");
+	ut.writeDebug("neighGraphPipe","Configured with parameters { dim: " + std::to_string(dim) + " , eps: " + configMap["epsilon"] + " , debug: " + strDebug + ", outputFile: " + outputFile + ", threads: " + std::to_string(threads) + " }");
 	
 	return true;
 }
@@ -8,6 +8,7 @@ class neighGraphPipe : public basePipe {
   private:
 	double epsilon;
 	int dim;
+	unsigned threads = 1;
   public:
     neighGraphPipe();
     pipePacket runPipe(pipePacket);
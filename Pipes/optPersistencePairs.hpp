@@ -6,6 +6,8 @@
 #include "basePipe.hpp"
 #include "utils.hpp"
 #include "indSimplexTree.hpp"
+#include "bitMatrix.hpp"
+#include "primeField.hpp"
 
 
 class optPersistencePairs : public basePipe {
@@ -14,13 +16,16 @@ class optPersistencePairs : public basePipe {
 	utils ut;
 	double maxEpsilon;
 	std::string twist;
+	std::string columnType = "vector";
+	unsigned threads = 1;
+	primeField field;
   public:
 	struct tArrayEntry_t{
 		bool marked = false;
 		int ti = -1;
 		double birth;
 		double death = -1;
-		std::set<unsigned> simplex;
+		smallSimplex simplex;
 	};
 	bool alterPipe = false;
 	
@@ -32,12 +37,10 @@ class optPersistencePairs : public basePipe {
     bool configPipe(std::map<std::string, std::string> configMap);
 	std::vector<std::vector<unsigned>> nSimplices(double, unsigned, std::vector<std::pair<double,std::vector<unsigned>>>);
 	int checkFace(std::vector<unsigned> face, std::vector<unsigned>);
-	int checkFace(std::set<unsigned> face, std::set<unsigned>);
-	std::pair<std::set<unsigned>,std::set<unsigned>> getRankNull(std::vector<std::vector<unsigned>>);
-	std::pair<std::set<unsigned>,std::set<unsigned>> getRankNull(std::vector<std::set<unsigned>>);
-	std::set<unsigned> getRankNull(std::vector<std::vector<indSimplexTree::graphEntry>>, pipePacket);
-	std::vector<std::vector<unsigned>> createBoundaryMatrix(std::vector<std::vector<std::pair<std::set<unsigned>,double>>> edges, int d, std::set<unsigned> pivots);
-	std::vector<std::set<unsigned>> createBoundarySets(std::vector<std::vector<indSimplexTree::graphEntry>>, int, std::set<unsigned>, pipePacket);
+	int checkFace(smallSimplex face, smallSimplex);
+	std::pair<std::set<unsigned>,std::set<unsigned>> getRankNull(bitMatrix);
+	std::map<unsigned, unsigned> getRankNull(std::vector<std::vector<indSimplexTree::graphEntry>>, pipePacket);
+	bitMatrix createBoundaryMatrix(std::vector<std::vector<std::pair<smallSimplex, double>>> edges, int d, std::set<unsigned> pivots);
 	void outputData(pipePacket);
 };
 
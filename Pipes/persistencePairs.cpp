@@ -16,6 +16,9 @@
 #include <functional>
 #include <algorithm>
 #include <set>
+#include "simplexHash.hpp"
+#include "unionFind.hpp"
+#include "twistReduction.hpp"
 #include "persistencePairs.hpp"
 
 
@@ -25,7 +28,7 @@ persistencePairs::persistencePairs(){
 	return;
 }
 
-bool sortBySecondAsc(const std::pair<std::set<unsigned>, double> &a, const std::pair<std::set<unsigned>, double> &b){
+bool sortBySecondAsc(const std::pair<smallSimplex, double> &a, const std::pair<smallSimplex, double> &b){
 	return (a.second < b.second);
 }
 	
@@ -55,7 +58,7 @@ int persistencePairs::checkFace(std::vector<unsigned> face, std::vector<unsigned
 }
 
 // Check if a face is a subset of a simplex
-int persistencePairs::checkFace(std::set<unsigned> face, std::set<unsigned> simplex){
+int persistencePairs::checkFace(smallSimplex face, smallSimplex simplex){
 	
 	if(simplex.size() == 0)
 		return 1;
@@ -66,49 +69,21 @@ int persistencePairs::checkFace(std::set<unsigned> face, std::set<unsigned> simp
 		return 0;
 }
 
-std::set<unsigned> persistencePairs::getRankNull(std::vector<std::vector<unsigned>> boundaryMatrix, unsigned offset){
+std::set<unsigned> persistencePairs::getRankNull(bitMatrix boundaryMatrix, unsigned offset){
 	
 	//Perform column echelon reduction; basically the inverse of the RREF
 	//	return offset index of pivots (ranks)
 	
 	std::set<unsigned> ret;
 	
-	//Step through each column and search for a one
-	for(unsigned i = 0; i < boundaryMatrix[0].size(); i++){
-		
-		//Step through each row
-		for(unsigned j = 0; j < boundaryMatrix.size(); j++){
-			
-			//If the vector has a 1 in the target column
-			if(boundaryMatrix[j][i] == 1){
-				ret.insert(j);
-	
-				//Create a temp matrix for XOR
-				std::vector<unsigned> tempColumn = boundaryMatrix[j];
-				
-				//Zero out our column and continue processing next column to clear any ones
-				//for(int z = 0; z < boundaryMatrix.size(); z++){
-				//	boundaryMatrix[j][i] = 0;
-			//	}
-				
-				//Iterate through remaining vectors and XOR with our vector or the clearRow
-				//j += 1;
-				while(j < boundaryMatrix.size()){
-					if(boundaryMatrix[j][i] == 1){
-						//XOR the remaining rows
-						for(unsigned d = 0; d < boundaryMatrix[0].size(); d++)
-							boundaryMatrix[j][d] = boundaryMatrix[j][d] ^ tempColumn[d];
-					}
-					j += 1;
-				}				
-			}
-		}
-	}
+	//Step through each column; the first vector with a one is XOR'd into the remaining
+	//		vectors with a one in that column
+	boundaryMatrix.eliminate([&](unsigned, unsigned pivot){ ret.insert(pivot); });
 	
 	return ret;
 }
 
-std::set<unsigned> persistencePairs::createBoundaryMatrix(std::vector<std::vector<std::pair<std::set<unsigned>,double>>> edges){
+std::set<unsigned> persistencePairs::createBoundaryMatrix(std::vector<std::vector<std::pair<smallSimplex, double>>> edges){
 	std::set<unsigned> pivots;
 	std::set<unsigned> lastPivots;
 		
@@ -123,30 +98,51 @@ std::set<unsigned> persistencePairs::createBoundaryMatrix(std::vector<std::vecto
 
 	
 		//Setup p-chains and n-chains
-		std::vector<std::pair<std::set<unsigned>,double>> nChain;
-		std::vector<std::pair<std::set<unsigned>,double>> pChain = edges[d];
+		std::vector<std::pair<smallSimplex, double>> nChain;
+		std::vector<std::pair<smallSimplex, double>> pChain = edges[d];
+		
+		//Edge pivots (the minimum spanning forest) come from union-find, no vertex-edge matrix
+		if(d == 1){
+			lastCount = lastCount - pChain.size();
+			for(auto merge : zeroPersistence(edges[0], pChain))
+				pivots.insert(lastCount + merge.edge);
+			continue;
+		}
 		
 		if(d == 0)
 			nChain = {};
 		else
 			nChain = edges[d-1];
 			
-		//Allocate the entire vector in a single step to reduce resizing during creation
-		std::vector<std::vector<unsigned>> tempBoundary (pChain.size(), std::vector<unsigned>(nChain.size(), 0));
+		//Allocate the entire (bit packed) matrix in a single step to reduce resizing during creation
+		bitMatrix tempBoundary (pChain.size(), nChain.size());
 			
-		//Create the columns (pChain), indexed by the rows in our pivot table
-		for(unsigned i = 0; i < pChain.size(); i++){
-			//Create the columns (pChain)
-			for(unsigned j = 0; j < nChain.size(); j++){
-				tempBoundary[i][j] = (checkFace(nChain[j].first, pChain[i].first));
+		//Create the columns (pChain) from keyed face lookups into the rows (nChain)
+		auto rows = boundaryRows(nChain, pChain);
+		if(!rows.empty()){
+			unsigned stride = rows.size() / pChain.size();
+			for(unsigned i = 0; i < pChain.size(); i++){
+				for(unsigned k = 0; k < stride; k++){
+					if(rows[i * stride + k] != noSimplex)
+						tempBoundary.set(i, rows[i * stride + k]);
+				}
+			}
+		} else {
+			//Keys would overflow; compare each column against every row
+			for(unsigned i = 0; i < pChain.size(); i++){
+				for(unsigned j = 0; j < nChain.size(); j++){
+					if(checkFace(nChain[j].first, pChain[i].first))
+						tempBoundary.set(i, j);
+				}
 			}
 		}
 		//Start a timer for physical time passed during the pipe's function
 		auto startTime = std::chrono::high_resolution_clock::now();
 		//Compute the pivots of the
-		lastPivots = getRankNull(tempBoundary, totalEdges - tempBoundary.size() - lastCount - 1);	
+		unsigned columns = tempBoundary.rows();
+		lastPivots = getRankNull(std::move(tempBoundary), totalEdges - columns - lastCount - 1);	
 		
-		lastCount = lastCount - tempBoundary.size();
+		lastCount = lastCount - columns;
 		
 		for(auto a : lastPivots)
 			pivots.insert(lastCount + a);
@@ -173,7 +169,7 @@ std::set<unsigned> persistencePairs::createBoundaryMatrix(std::vector<std::vecto
 pipePacket persistencePairs::runPipe(pipePacket inData){
 	
 	//Get all edges for the simplexArrayList or simplexTree
-	std::vector<std::vector<std::pair<std::set<unsigned>,double>>> edges = inData.complex->getAllEdges(maxEpsilon);
+	std::vector<std::vector<std::pair<smallSimplex, double>>> edges = inData.complex->getAllEdges(maxEpsilon);
 	
 	//Get all dim 0 pairs
 	
@@ -198,12 +194,17 @@ pipePacket persistencePairs::runPipe(pipePacket inData){
 	//		Success!
 	
 	//Generate our boundary matrix and retrieve pivots
-	std::set<unsigned> kPivots = createBoundaryMatrix(edges);
+	//	twist: sparse reduction from the top dimension down, clearing positive columns
+	std::set<unsigned> kPivots;
+	if(twist == "true" && !edges.empty())
+		kPivots = negativeSimplices(edges, edges.size() - 1, columnType, threads, field);
+	else
+		kPivots = createBoundaryMatrix(edges);
 	
 	std::string bettis = "dim,birth,death\n";
 	
 	//Flatten the edges into a single array
-	std::vector<std::set<unsigned>> kSimplices;
+	std::vector<smallSimplex> kSimplices;
 	std::vector<double> kWeights;
 	for(auto a : edges){		
 		for(auto z : a){
@@ -236,16 +237,16 @@ pipePacket persistencePairs::runPipe(pipePacket inData){
 			tArray[curIndex].marked = true;
 			
 		} else {
-			int iter = tArray.size();
+			int iter = tArray.size() - 1;
 			for(; iter >= 0; iter--){
 				if(tArray[iter].marked && tArray[iter].death < 0 && tArray[curIndex].simplex.size() != kSimplices[iter].size() && ut.setIntersect(kSimplices[iter], tArray[curIndex].simplex, false).size() == tArray[curIndex].simplex.size() - 1)
 					break;
 			}
-			if(iter != 0){
+			if(iter > 0){
 				if(tArray[iter].death < 0 ){
 					tArray[iter].death = kWeights[curIndex];
 					
-					if(tArray[iter].death != tArray[iter].birth)
+					if(tArray[iter].death != tArray[iter].birth && tArray[iter].death - tArray[iter].birth >= minPersistence)
 						bettis += std::to_string(tArray[curIndex].simplex.size() - 2) + "," + std::to_string(tArray[iter].birth) + "," + std::to_string(kWeights[curIndex]) + "\n";
 				}
 			}
@@ -261,7 +262,8 @@ pipePacket persistencePairs::runPipe(pipePacket inData){
 	for(int t = 0; t < kSimplices.size(); t++){
 		if(tArray[t].marked && tArray[t].death == -1 && tArray[t].simplex.size() < dim){
 			ret[tArray[t].simplex.size()].push_back(std::make_pair(kWeights[t], maxEpsilon));
-			bettis += std::to_string(0) + "," + std::to_string(tArray[t].birth) + "," + std::to_string(maxEpsilon) + "\n";
+			if(maxEpsilon - tArray[t].birth >= minPersistence)
+				bettis += std::to_string(0) + "," + std::to_string(tArray[t].birth) + "," + std::to_string(maxEpsilon) + "\n";
 		}
 	}
 	
@@ -341,6 +343,14 @@ bool persistencePairs::configPipe(std::map<std::string, std::string> configMap){
 		twist = configMap["twist"];
 	else return false;
 	
+	pipe = configMap.find("columnType");
+	if(pipe != configMap.end())
+		columnType = configMap["columnType"];
+	
+	pipe = configMap.find("threads");
+	if(pipe != configMap.end())
+		threads = std::max(1, std::atoi(configMap["threads"].c_str()));
+	
 	pipe = configMap.find("fn");
 	if(pipe != configMap.end())
 		fnmod = configMap["fn"];
@@ -349,8 +359,26 @@ bool persistencePairs::configPipe(std::map<std::string, std::string> configMap){
 	if(pipe != configMap.end() && configMap["complexType"] == "indSimplexTree")
 		alterPipe = true;
 		
+	pipe = configMap.find("minPersistence");
+	if(pipe != configMap.end())
+		minPersistence = std::atof(configMap["minPersistence"].c_str());
+	
+	//Z/p goes through the sparse (twistReduce) columns; the bitMatrix path is Z2 only
+	pipe = configMap.find("coeff");
+	if(pipe != configMap.end()){
+		unsigned p = std::atoi(configMap["coeff"].c_str());
+		if(primeField::isPrime(p) && p <= primeField::maxCharacteristic)
+			field = primeField(p);
+		else
+			ut.writeError("persistence","coeff " + configMap["coeff"] + " is not a prime up to " + std::to_string(primeField::maxCharacteristic) + ", using 2");
+	}
+	if(field.characteristic() != 2 && twist != "true"){
+		ut.writeError("persistence","coeff " + configMap["coeff"] + " requires twist");
+		return false;
+	}
+		
 	configured = true;
-	ut.writeDebug("persistence","Configured with parameters { dim: " + configMap["dimensions"] + ", twist: " + twist + ", complexType: " + configMap["complexType"] + ", eps: " + configMap["epsilon"]);
+	ut.writeDebug("persistence","Configured with parameters { dim: " + configMap["dimensions"] + ", twist: " + twist + ", columnType: " + columnType + ", threads: " + std::to_string(threads) + ", coeff: " + std::to_string(field.characteristic()) + ", complexType: " + configMap["complexType"] + ", eps: " + configMap["epsilon"]);
 	ut.writeDebug("persistence","\t\t\t\tdebug: " + strDebug + ", outputFile: " + outputFile + " }");
 	
 	return true;
@@ -5,6 +5,8 @@
 #include <queue>
 #include "basePipe.hpp"
 #include "utils.hpp"
+#include "bitMatrix.hpp"
+#include "primeField.hpp"
 
 
 class persistencePairs : public basePipe {
@@ -13,13 +15,16 @@ class persistencePairs : public basePipe {
 	utils ut;
 	double maxEpsilon;
 	std::string twist;
+	std::string columnType = "vector";
+	unsigned threads = 1;
+	primeField field;
   public:
 	struct tArrayEntry_t{
 		bool marked = false;
 		int ti = -1;
 		double birth;
 		double death = -1;
-		std::set<unsigned> simplex;
+		smallSimplex simplex;
 	};
 	bool alterPipe = false;
 	
@@ -31,9 +36,9 @@ class persistencePairs : public basePipe {
     bool configPipe(std::map<std::string, std::string> configMap);
 	std::vector<std::vector<unsigned>> nSimplices(double, unsigned, std::vector<std::pair<double,std::vector<unsigned>>>);
 	int checkFace(std::vector<unsigned> face, std::vector<unsigned>);
-	int checkFace(std::set<unsigned> face, std::set<unsigned>);
-	std::set<unsigned> getRankNull(std::vector<std::vector<unsigned>>, unsigned);
-	std::set<unsigned> createBoundaryMatrix(std::vector<std::vector<std::pair<std::set<unsigned>,double>>>);
+	int checkFace(smallSimplex face, smallSimplex);
+	std::set<unsigned> getRankNull(bitMatrix, unsigned);
+	std::set<unsigned> createBoundaryMatrix(std::vector<std::vector<std::pair<smallSimplex, double>>>);
 	void outputData(pipePacket);
 };
 
@@ -0,0 +1,269 @@
+#pragma once
+
+#ifndef PIVOTCOLUMN_HPP_INCL
+#define PIVOTCOLUMN_HPP_INCL
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include "simplexHash.hpp"
+#include "primeField.hpp"
+
+// Header only working column representations for Z2 matrix reduction (see PHAT, Bauer-17)
+//		Reduced columns are stored as sorted row vectors; the column being reduced is held
+//		in one of the representations below while pivot columns are added to it:
+//
+//		vectorColumn	- sorted vector, each addition is a merge (symmetric difference)
+//		heapColumn		- max-heap, additions are pushes; equal rows cancel when they
+//							reach the top (lazy), pruned once it holds too many entries
+//		bitTreeColumn	- 64-ary bit tree over the rows, toggles and the pivot are
+//							O(log_64 rows) with count leading zeros at each level
+//		fullColumn		- dense scratch of every row plus a heap of touched rows
+//
+//		Each provides init(rows), load(column), add(column), pivot() (largest row, noSimplex
+//		if zero) and store(column), which writes the sorted rows and empties the column.
+//
+//		fieldColumn is the same interface over Z/p, with (row, coefficient) entries; add
+//		scales the pivot column so that it cancels the current pivot.
+
+class vectorColumn {
+  private:
+	std::vector<unsigned> rows;
+	std::vector<unsigned> sum;
+
+  public:
+	void init(unsigned){ rows.clear(); };
+	void load(const std::vector<unsigned>& column){ rows = column; };
+
+	void add(const std::vector<unsigned>& column){
+		sum.clear();
+		std::set_symmetric_difference(rows.begin(), rows.end(), column.begin(), column.end(), std::back_inserter(sum));
+		rows.swap(sum);
+	};
+
+	unsigned pivot() const { return rows.empty() ? noSimplex : rows.back(); };
+
+	void store(std::vector<unsigned>& column){
+		column.swap(rows);
+		rows.clear();
+	};
+};
+
+
+class heapColumn {
+  private:
+	std::vector<unsigned> heap;
+	size_t pruneSize = 64;
+
+	unsigned popTop(){
+		std::pop_heap(heap.begin(), heap.end());
+		unsigned ret = heap.back();
+		heap.pop_back();
+		return ret;
+	};
+
+	// Largest row with odd multiplicity, removed from the heap; noSimplex if zero
+	unsigned popPivot(){
+		while(!heap.empty()){
+			unsigned top = popTop();
+			if(heap.empty() || heap.front() != top)
+				return top;
+			popTop();
+		}
+		return noSimplex;
+	};
+
+	void prune(){
+		std::vector<unsigned> column;
+		store(column);
+		load(column);
+		pruneSize = std::max<size_t>(64, 2 * heap.size());
+	};
+
+  public:
+	void init(unsigned){ heap.clear(); pruneSize = 64; };
+
+	void load(const std::vector<unsigned>& column){
+		heap = column;
+		std::make_heap(heap.begin(), heap.end());
+	};
+
+	void add(const std::vector<unsigned>& column){
+		for(auto row : column){
+			heap.push_back(row);
+			std::push_heap(heap.begin(), heap.end());
+		}
+		if(heap.size() > pruneSize)
+			prune();
+	};
+
+	unsigned pivot(){
+		unsigned ret = popPivot();
+		if(ret != noSimplex){
+			heap.push_back(ret);
+			std::push_heap(heap.begin(), heap.end());
+		}
+		return ret;
+	};
+
+	void store(std::vector<unsigned>& column){
+		column.clear();
+		for(unsigned row = popPivot(); row != noSimplex; row = popPivot())
+			column.push_back(row);
+		std::reverse(column.begin(), column.end());
+	};
+};
+
+
+class bitTreeColumn {
+  private:
+	typedef unsigned long long word;
+	std::vector<std::vector<word>> levels;			//levels[0] holds the row bits, each level above one bit per word below
+
+	static unsigned highest(word w){ return 63 - __builtin_clzll(w); };
+
+	void toggle(unsigned row){
+		unsigned index = row;
+		for(unsigned l = 0; l < levels.size(); l++){
+			word& w = levels[l][index / 64];
+			bool wasZero = (w == 0);
+			w ^= (word)1 << (index % 64);
+			//Parents only change when a word switches between zero and non-zero
+			if(wasZero != (w == 0))
+				index /= 64;
+			else
+				break;
+		}
+	};
+
+  public:
+	void init(unsigned rows){
+		levels.clear();
+		unsigned words = std::max<unsigned>(1, (rows + 63) / 64);
+		while(true){
+			levels.push_back(std::vector<word>(words, 0));
+			if(words == 1)
+				break;
+			words = (words + 63) / 64;
+		}
+	};
+
+	void load(const std::vector<unsigned>& column){
+		for(auto row : column)
+			toggle(row);
+	};
+	void add(const std::vector<unsigned>& column){ load(column); };
+
+	unsigned pivot() const {
+		if(levels.empty() || levels.back()[0] == 0)
+			return noSimplex;
+		unsigned index = 0;
+		for(unsigned l = levels.size(); l-- > 0;)
+			index = index * 64 + highest(levels[l][index]);
+		return index;
+	};
+
+	void store(std::vector<unsigned>& column){
+		column.clear();
+		for(unsigned row = pivot(); row != noSimplex; row = pivot()){
+			column.push_back(row);
+			toggle(row);
+		}
+		std::reverse(column.begin(), column.end());
+	};
+};
+
+
+class fullColumn {
+  private:
+	std::vector<char> present;
+	std::vector<unsigned> touched;					//Max-heap of rows set at some point, may be stale
+
+	void toggle(unsigned row){
+		present[row] ^= 1;
+		if(present[row]){
+			touched.push_back(row);
+			std::push_heap(touched.begin(), touched.end());
+		}
+	};
+
+  public:
+	void init(unsigned rows){
+		present.assign(rows, 0);
+		touched.clear();
+	};
+
+	void load(const std::vector<unsigned>& column){
+		for(auto row : column)
+			toggle(row);
+	};
+	void add(const std::vector<unsigned>& column){ load(column); };
+
+	unsigned pivot(){
+		while(!touched.empty() && !present[touched.front()]){
+			std::pop_heap(touched.begin(), touched.end());
+			touched.pop_back();
+		}
+		return touched.empty() ? noSimplex : touched.front();
+	};
+
+	void store(std::vector<unsigned>& column){
+		column.clear();
+		while(!touched.empty()){
+			std::pop_heap(touched.begin(), touched.end());
+			unsigned row = touched.back();
+			touched.pop_back();
+			if(present[row]){
+				present[row] = 0;
+				column.push_back(row);
+			}
+		}
+		std::reverse(column.begin(), column.end());
+	};
+};
+
+
+class fieldColumn {
+  private:
+	const primeField* field = nullptr;
+	std::vector<fieldEntry> entries;
+	std::vector<fieldEntry> scratch;
+
+  public:
+	fieldColumn(){};
+	fieldColumn(const primeField& field) : field(&field){};
+
+	void init(unsigned){ entries.clear(); };
+	void load(const std::vector<fieldEntry>& column){ entries = column; };
+
+	// Entries += factor * column, with factor = -c / c' for the pivot coefficients c, c'
+	void add(const std::vector<fieldEntry>& column){
+		unsigned factor = field->mul(field->neg(entries.back().coeff), field->inverse(column.back().coeff));
+		field->addScaled(entries, factor, column, scratch);
+	};
+
+	unsigned pivot() const { return entries.empty() ? noSimplex : entries.back().row; };
+
+	void store(std::vector<fieldEntry>& column){
+		column.swap(entries);
+		entries.clear();
+	};
+};
+
+
+// Resolve a column type name once, then run f(column) with a working column of that type
+//		f is a generic lambda; unknown names fall back to vector
+template<typename F>
+auto dispatchColumn(const std::string& columnType, F&& f){
+	if(columnType == "heap")
+		return f(heapColumn());
+	else if(columnType == "bit_tree")
+		return f(bitTreeColumn());
+	else if(columnType == "full")
+		return f(fullColumn());
+
+	return f(vectorColumn());
+}
+
+#endif
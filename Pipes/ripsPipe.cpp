@@ -28,6 +28,9 @@ ripsPipe::ripsPipe(){
 // runPipe -> Run the configured functions of this pipeline segment
 pipePacket ripsPipe::runPipe(pipePacket inData){
 	
+	//Complexes that expand after insertion (simplexArrayList) split the work over the threads;
+	//		the trees are built over them during insertion (neighGraph)
+	inData.complex->threads = threads;
 	inData.complex->expandDimensions(dim);
 		
 	ut.writeDebug("ripsPipe","Expanded Complex Size: " + std::to_string(inData.complex->simplexCount()));
@@ -67,8 +70,12 @@ bool ripsPipe::configPipe(std::map<std::string, std::string> configMap){
 	if(pipe != configMap.end())
 		collapse = configMap["collapse"];
 	
+	pipe = configMap.find("threads");
+	if(pipe != configMap.end())
+		threads = std::max(1, std::atoi(configMap["threads"].c_str()));
+	
 	configured = true;
-	ut.writeDebug("ripsPipe","Configured with parameters { dim: " + std::to_string(dim) + " , debug: " + strDebug + ", outputFile: " + outputFile + ", collapse: " + collapse + " }");
+	ut.writeDebug("ripsPipe","Configured with parameters { dim: " + std::to_string(dim) + " , debug: " + strDebug + ", outputFile: " + outputFile + ", collapse: " + collapse + ", threads: " + std::to_string(threads) + " }");
 	
 	return true;
 }
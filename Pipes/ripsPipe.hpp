@@ -9,6 +9,7 @@ class ripsPipe : public basePipe {
   public:
 	std::string collapse;
 	int dim;
+	unsigned threads = 1;
     ripsPipe();
     pipePacket runPipe(pipePacket);
     bool configPipe(std::map<std::string, std::string>);
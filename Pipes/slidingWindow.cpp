@@ -16,6 +16,8 @@
 #include <functional>
 #include "slidingWindow.hpp"
 #include "readInput.hpp"
+#include "distanceMetrics.hpp"
+#include "filtrationValue.hpp"
 
 
 // basePipe constructor
@@ -70,11 +72,8 @@ void slidingWindow::updateStats()
     std::vector<double> distsFromCurrVecTP;  // A vector to store the distances from the current vector to the ones in the target partition.
     std::vector<int> tpIndices; // A vector to store the positions of the existing members of the target partition.
 
-    // Add a new column and row to the end of the upper triangular distance matrix.
     for(unsigned int i = 0; i < pPack->complex->distMatrix.size(); i++)
     {
-        pPack->complex->distMatrix[i].push_back( defaultVals->distsFromCurrVec[i] );
-
         // Update NN statistics for only those partitions from which the point was deleted or to which the new point is to be added.
         // Case 1: The i-th point belongs to the partition the last point was deleted from, but not to the partition the new point is
         // to be added to. And, the point that was deleted was the nearest neighbor of the i-th point.
@@ -104,12 +103,12 @@ void slidingWindow::updateStats()
                     {
                         if (j < i)
                         {
-                            memberDistsFromVect.push_back( pPack->complex->distMatrix[j][i] );
+                            memberDistsFromVect.push_back( pPack->complex->distMatrix(j, i) );
                             memberIndices.push_back(j);
                         }
                         else if (j > i)
                         {
-                            memberDistsFromVect.push_back( pPack->complex->distMatrix[i][j] );
+                            memberDistsFromVect.push_back( pPack->complex->distMatrix(i, j) );
                             memberIndices.push_back(j);
                         }
                     }
@@ -215,12 +214,12 @@ void slidingWindow::updateStats()
                     {
                         if (j < i)
                         {
-                            memberDistsFromVect.push_back( pPack->complex->distMatrix[j][i] );
+                            memberDistsFromVect.push_back( pPack->complex->distMatrix(j, i) );
                             memberIndices.push_back(j);
                         }
                         else if (j > i)
                         {
-                            memberDistsFromVect.push_back( pPack->complex->distMatrix[i][j] );
+                            memberDistsFromVect.push_back( pPack->complex->distMatrix(i, j) );
                             memberIndices.push_back(j);
                         }
                     }
@@ -241,7 +240,8 @@ void slidingWindow::updateStats()
         }
 
     }
-    pPack->complex->distMatrix.push_back( defaultVals->distMatLastRow );
+    // Add a new column to the end of the condensed upper triangular distance matrix.
+    pPack->complex->distMatrix.appendPoint( defaultVals->distsFromCurrVec );
 
     // Update the average NN distance of the partition from which the last point was deleted and of the one to which the new point
     // is being added.
@@ -312,7 +312,9 @@ bool slidingWindow::nnBasedEvaluator(std::vector<double>& currentVector, std::ve
     defaultVals->distsFromCurrVec.clear();
 
     // Compute the distances from the current vector to the existing ones in the window.
-    defaultVals->distsFromCurrVec = ut.nearestNeighbors(currentVector, windowValues);
+    defaultVals->distsFromCurrVec = metricDistances(metric, currentVector, windowValues);
+    for(auto &dist : defaultVals->distsFromCurrVec)
+        dist = roundFiltration(dist);
 
     // Find the distance from the current vector to its nearest neighbor in the window.
     auto nnDistCurrVec = *std::min_element( defaultVals->distsFromCurrVec.begin(), defaultVals->distsFromCurrVec.end() );
@@ -493,6 +495,7 @@ bool slidingWindow::nnBasedEvaluator(std::vector<double>& currentVector, std::ve
 
 slidingWindow::EvalParams* slidingWindow::defaultVals = new EvalParams{ 200, 0, 0 };
 pipePacket* slidingWindow::pPack;
+std::string slidingWindow::metric = "euclidean";
 
 
 // runPipe -> Run the configured functions of this pipeline segment
@@ -661,44 +664,50 @@ void slidingWindow::runComplexInitializer(pipePacket &inData, std::vector<int> &
     utils ut;
 
     //Store our distance matrix
-    std::vector<std::vector<double>> distMatrix (inData.originalData.size(), std::vector<double>(inData.originalData.size(),0));
+    condensedDistMatrix distMatrix(inData.originalData.size());
 
-    //Iterate through each vector
-    for(unsigned i = 0; i < inData.originalData.size(); i++)
+    //Iterate through each vector (metric resolved once for the whole window)
+    unsigned d = inData.originalData[0].size();
+    dispatchMetric(metric, d, [&](auto m, auto dim)
     {
-        if(!inData.originalData[i].empty())
+        using metricT = decltype(m);
+        using dimT = decltype(dim);
+        for(unsigned i = 0; i < inData.originalData.size(); i++)
         {
-            std::vector<double> distsFromCurrVect;
-
-            for(unsigned j = 0; j < inData.originalData.size(); j++)
+            if(!inData.originalData[i].empty())
             {
-                if (j < i)
-                {
-                    distsFromCurrVect.push_back( distMatrix[j][i] );
-                }
-                else if (j > i)
+                std::vector<double> distsFromCurrVect;
+
+                for(unsigned j = 0; j < inData.originalData.size(); j++)
                 {
-                    //Calculate vector distance
-                    auto dist = ut.vectors_distance(inData.originalData[i], inData.originalData[j]);
-                    if(dist < epsilon)
-                        inData.weights.insert(dist);
-                    distMatrix[i][j] = dist;
-                    distsFromCurrVect.push_back( dist );
+                    if (j < i)
+                    {
+                        distsFromCurrVect.push_back( distMatrix(j, i) );
+                    }
+                    else if (j > i)
+                    {
+                        //Calculate vector distance
+                        auto dist = roundFiltration(metricDistance<metricT, dimT>(inData.originalData[i], inData.originalData[j]));
+                        if(dist < epsilon)
+                            inData.weights.insert(dist);
+                        distMatrix.set(i, j, dist);
+                        distsFromCurrVect.push_back( dist );
+                    }
                 }
-            }
 
-            auto tempIndex = std::min_element(distsFromCurrVect.begin(), distsFromCurrVect.end()) - distsFromCurrVect.begin();
-            if (tempIndex < i)
-                nnIndices.push_back(tempIndex);
-            else
-                nnIndices.push_back(tempIndex + 1);
+                auto tempIndex = std::min_element(distsFromCurrVect.begin(), distsFromCurrVect.end()) - distsFromCurrVect.begin();
+                if (tempIndex < i)
+                    nnIndices.push_back(tempIndex);
+                else
+                    nnIndices.push_back(tempIndex + 1);
 
-            auto nnDistFromCurrVect = *std::min_element( distsFromCurrVect.begin(), distsFromCurrVect.end() );
-            nnDists.push_back( nnDistFromCurrVect );
+                auto nnDistFromCurrVect = *std::min_element( distsFromCurrVect.begin(), distsFromCurrVect.end() );
+                nnDists.push_back( nnDistFromCurrVect );
+            }
         }
-    }
+    });
 
-    inData.complex->setDistanceMatrix(distMatrix);
+    inData.complex->setDistanceMatrix(std::move(distMatrix));
 
     inData.weights.insert(0.0);
     inData.weights.insert(epsilon);
@@ -762,6 +771,15 @@ bool slidingWindow::configPipe(std::map<std::string, std::string> configMap)
     }
     else return false;
 
+    pipe = configMap.find("metric");
+    if(pipe != configMap.end())
+        metric = configMap["metric"];
+    if(!validMetric(metric))
+    {
+        ut.writeError("slidingWindow", "Unknown metric: " + metric);
+        return false;
+    }
+
     configured = true;
     ut.writeDebug("slidingWindow","Configured with parameters { input: " + configMap["inputFile"] + ", dim: " + configMap["dimensions"] + ", eps: " + configMap["epsilon"] + ", debug: " + strDebug + ", outputFile: " + outputFile + " }");
 
@@ -34,11 +34,11 @@ public:
         int labelToBeDeleted;
         int indexToBeDeleted;
         double nnDistToBeDeleted;
-        std::vector<double> distMatLastRow;//(windowMaxSize, 0);  // The last row of the upper triangular distance matrix is a vector of 0s.
     };
     
     static EvalParams* defaultVals;
     static pipePacket* pPack;
+    static std::string metric;
     
     slidingWindow();
     pipePacket runPipe(pipePacket);
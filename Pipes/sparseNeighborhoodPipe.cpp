@@ -0,0 +1,161 @@
+/*
+ * sparseNeighborhoodPipe hpp + cpp extend the basePipe class for building
+ * the sparse epsilon-neighborhood graph (CSR) of the data input from kdTree
+ * range queries; a replacement for distMatrix when epsilon is small
+ * relative to the data diameter
+ * 
+ */
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <thread>
+#include "sparseNeighborhoodPipe.hpp"
+#include "kdTree.hpp"
+#include "utils.hpp"
+#include "distanceMetrics.hpp"
+#include "filtrationValue.hpp"
+
+// basePipe constructor
+sparseNeighborhoodPipe::sparseNeighborhoodPipe(){
+	pipeType = "SparseNeighborhood";
+	return;
+}
+
+// runPipe -> Run the configured functions of this pipeline segment
+pipePacket sparseNeighborhoodPipe::runPipe(pipePacket inData){
+	unsigned n = inData.originalData.size();
+	if(n == 0)
+		return inData;
+	
+	kdTree tree(inData.originalData, n);
+	
+	//Range query each point, rows are split across threads
+	std::vector<std::vector<std::pair<unsigned, double>>> adjacency(n);
+	std::vector<std::vector<double>> threadWeights(threads);
+	
+	//Resolve the metric once; the kdTree is queried with the euclidean radius
+	//	containing the metric ball, then candidates are filtered by the metric
+	unsigned d = inData.originalData[0].size();
+	auto worker = dispatchMetric(metric, d, [&](auto m, auto dim){
+		using metricT = decltype(m);
+		using dimT = decltype(dim);
+		double radius = metricT::euclideanBound(maxEpsilon, d);
+		bool single = (precision == condensedDistMatrix::storeFloat);
+		
+		return std::function<void(unsigned)>([&, radius, single](unsigned tid){
+			for(unsigned i = tid; i < n; i += threads){
+				if(inData.originalData[i].empty())
+					continue;
+				
+				for(auto j : tree.neighborhoodIndices(inData.originalData[i], radius)){
+					if(j == i)
+						continue;
+					
+					auto dist = roundFiltration(metricDistance<metricT, dimT>(inData.originalData[i], inData.originalData[j]), single);
+					if(dist > maxEpsilon)
+						continue;
+					
+					adjacency[i].push_back(std::make_pair((unsigned)j, dist));
+					
+					if(j > i && dist < maxEpsilon)
+						threadWeights[tid].push_back(dist);
+				}
+			}
+		});
+	});
+	
+	std::vector<std::thread> workers;
+	for(unsigned t = 1; t < threads; t++)
+		workers.push_back(std::thread(worker, t));
+	worker(0);
+	for(auto &w : workers)
+		w.join();
+	
+	//Merge the per-thread weights; sorted descending they append at the end of the set
+	std::vector<double> allWeights;
+	for(auto &w : threadWeights)
+		allWeights.insert(allWeights.end(), w.begin(), w.end());
+	std::sort(allWeights.begin(), allWeights.end(), std::greater<double>());
+	allWeights.erase(std::unique(allWeights.begin(), allWeights.end()), allWeights.end());
+	for(auto w : allWeights)
+		inData.weights.insert(inData.weights.end(), w);
+	
+	sparseNeighborGraph graph(adjacency);
+	ut.writeDebug("sparseNeighborhood", "\tNeighborhood Graph: " + std::to_string(graph.size()) + " points, " + std::to_string(graph.edgeCount()) + " edges");
+	
+	inData.complex->setNeighborGraph(std::move(graph));
+	
+	inData.weights.insert(0.0);
+	inData.weights.insert(maxEpsilon);
+	return inData;
+}
+
+
+// configPipe -> configure the function settings of this pipeline segment
+bool sparseNeighborhoodPipe::configPipe(std::map<std::string, std::string> configMap){
+	std::string strDebug;
+	
+	auto pipe = configMap.find("debug");
+	if(pipe != configMap.end()){
+		debug = std::atoi(configMap["debug"].c_str());
+		strDebug = configMap["debug"];
+	}
+	pipe = configMap.find("outputFile");
+	if(pipe != configMap.end())
+		outputFile = configMap["outputFile"].c_str();
+	
+	ut = utils(strDebug, outputFile);
+	
+	pipe = configMap.find("epsilon");
+	if(pipe != configMap.end())
+		maxEpsilon = std::atof(configMap["epsilon"].c_str());
+	else return false;
+	
+	pipe = configMap.find("metric");
+	if(pipe != configMap.end())
+		metric = configMap["metric"];
+	if(!validMetric(metric)){
+		ut.writeError("sparseNeighborhoodPipe", "Unknown metric: " + metric);
+		return false;
+	}
+	
+	pipe = configMap.find("threads");
+	if(pipe != configMap.end())
+		threads = std::max(1, std::atoi(configMap["threads"].c_str()));
+	
+	pipe = configMap.find("precision");
+	if(pipe != configMap.end() && !condensedDistMatrix::parseStorage(configMap["precision"], precision)){
+		ut.writeError("sparseNeighborhoodPipe", "Unknown precision: " + configMap["precision"]);
+		return false;
+	}
+	
+	configured = true;
+	ut.writeDebug("sparseNeighborhoodPipe","Configured with parameters { eps: " + configMap["epsilon"] + ", metric: " + metric + ", threads: " + std::to_string(threads) + " , debug: " + strDebug + ", outputFile: " + outputFile + " }");
+	
+	return true;
+}
+
+// outputData -> used for tracking each stage of the pipeline's data output without runtime
+void sparseNeighborhoodPipe::outputData(pipePacket inData){
+	std::ofstream file;
+	file.open("output/" + pipeType + "_output.csv");
+	
+	//Write each edge once (i < j) as i,j,distance
+	auto &graph = inData.complex->neighborGraph;
+	for(unsigned i = 0; i < graph.size(); i++){
+		auto w = graph.weightsBegin(i);
+		for(auto j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++, w++){
+			if(*j > i)
+				file << i << "," << *j << "," << *w << "\n";
+		}
+	}
+	
+	file.close();
+	return;
+}
+
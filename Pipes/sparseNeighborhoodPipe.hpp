@@ -0,0 +1,19 @@
+#pragma once
+
+// Header file for sparseNeighborhoodPipe class - see sparseNeighborhoodPipe.cpp for descriptions
+#include <map>
+#include "basePipe.hpp"
+
+class sparseNeighborhoodPipe : public basePipe {
+  private:
+	double maxEpsilon;
+	unsigned threads = 1;
+	std::string metric = "euclidean";
+	condensedDistMatrix::valueStorage precision = condensedDistMatrix::storeDouble;
+  public:
+    sparseNeighborhoodPipe();
+    pipePacket runPipe(pipePacket inData);
+    bool configPipe(std::map<std::string, std::string> configMap);
+	void outputData(pipePacket);
+};
+
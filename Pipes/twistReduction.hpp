@@ -0,0 +1,391 @@
+#pragma once
+
+#ifndef TWISTREDUCTION_HPP_INCL
+#define TWISTREDUCTION_HPP_INCL
+
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include "simplexHash.hpp"
+#include "unionFind.hpp"
+#include "pivotColumn.hpp"
+#include "primeField.hpp"
+
+// Header only boundary matrix reduction with clearing (twist, see Chen-Kerber-11)
+//		Dimensions are reduced from the top down. A simplex that is the pivot (low) of a
+//		column one dimension up is positive, so its own column reduces to zero and is
+//		skipped without any column additions. Columns are sorted row index vectors,
+//		reduced left to right by the standard algorithm (low = largest row) in a working
+//		column of the selected representation (see pivotColumn.hpp). Over Z/p (p > 2)
+//		columns carry signed coefficients instead (see primeField.hpp) and go through the
+//		same reduction in a fieldColumn.
+
+struct reducedBoundary {
+	std::vector<std::vector<unsigned>> low;						//low[d][j]: row (dimension d-1) paired with column j, noSimplex if zero
+	std::vector<std::vector<std::vector<unsigned>>> columns;	//columns[d][j]: reduced column (if kept)
+	unsigned long long additions = 0;							//Column additions performed
+	unsigned long long cleared = 0;								//Columns skipped by clearing
+};
+
+// Row of a column entry (Z2 columns hold rows only)
+inline unsigned entryRow(unsigned row){ return row; }
+inline unsigned entryRow(const fieldEntry& entry){ return entry.row; }
+
+// Rows (positions in nChain) of the faces of each pChain simplex, sorted; chains are
+//		(simplex, weight) lists
+template<typename Chain>
+std::vector<std::vector<unsigned>> boundaryColumns(const Chain& nChain, const Chain& pChain){
+	std::vector<std::vector<unsigned>> ret(pChain.size());
+
+	auto rows = boundaryRows(nChain, pChain);
+	if(!rows.empty()){
+		unsigned stride = rows.size() / pChain.size();
+		for(unsigned i = 0; i < pChain.size(); i++){
+			for(unsigned k = 0; k < stride; k++)
+				if(rows[i * stride + k] != noSimplex)
+					ret[i].push_back(rows[i * stride + k]);
+			std::sort(ret[i].begin(), ret[i].end());
+		}
+	} else {
+		//Keys would overflow; check each row for intersection
+		for(unsigned i = 0; i < pChain.size(); i++)
+			for(unsigned j = 0; j < nChain.size(); j++)
+				if(nChain[j].first.size() + 1 == pChain[i].first.size() && std::includes(pChain[i].first.begin(), pChain[i].first.end(), nChain[j].first.begin(), nChain[j].first.end()))
+					ret[i].push_back(j);
+	}
+
+	return ret;
+}
+
+// Signed columns over Z/p: face k (vertex k removed) of a simplex has coefficient (-1)^k
+template<typename Chain>
+std::vector<std::vector<fieldEntry>> boundaryColumns(const Chain& nChain, const Chain& pChain, const primeField& field){
+	std::vector<std::vector<fieldEntry>> ret(pChain.size());
+	auto byRow = [](const fieldEntry& a, const fieldEntry& b){ return a.row < b.row; };
+
+	auto rows = boundaryRows(nChain, pChain);
+	if(!rows.empty()){
+		unsigned stride = rows.size() / pChain.size();
+		for(unsigned i = 0; i < pChain.size(); i++){
+			for(unsigned k = 0; k < stride; k++)
+				if(rows[i * stride + k] != noSimplex)
+					ret[i].push_back(fieldEntry{rows[i * stride + k], field.fromInt(k % 2 ? -1 : 1)});
+			std::sort(ret[i].begin(), ret[i].end(), byRow);
+		}
+	} else {
+		//Keys would overflow; check each row for intersection, the sign from the vertex missing
+		for(unsigned i = 0; i < pChain.size(); i++){
+			for(unsigned j = 0; j < nChain.size(); j++){
+				auto& simplex = pChain[i].first;
+				auto& face = nChain[j].first;
+				if(face.size() + 1 != simplex.size() || !std::includes(simplex.begin(), simplex.end(), face.begin(), face.end()))
+					continue;
+				unsigned k = 0;
+				auto f = face.begin();
+				for(auto v = simplex.begin(); v != simplex.end() && f != face.end() && *v == *f; v++, f++)
+					k++;
+				ret[i].push_back(fieldEntry{j, field.fromInt(k % 2 ? -1 : 1)});
+			}
+		}
+	}
+
+	return ret;
+}
+
+// Reduce columns (sorted rows < nRows) left to right by the standard algorithm (low = largest
+//		row); columns flagged in skip are zeroed without reduction. Reduced columns are left in
+//		place, returns the low of each column (noSimplex if zero).
+//
+//		threads > 1 uses the chunk algorithm (Bauer-Kerber-Reininghaus-14): columns are split
+//		into contiguous chunks reduced in parallel against pivots of their own chunk only. A row
+//		past every row of the columns left of a chunk can not be the low of any of those, so a
+//		low reached there is final. The remaining columns are then reduced in order against all
+//		pivots. Pairs match the sequential reduction; reduced columns may be other (equally valid)
+//		representatives.
+//
+//		Entries are rows (Z2) or fieldEntry (Z/p); each working column is a copy of prototype.
+template<typename Column, typename Entry>
+std::vector<unsigned> reduceColumns(std::vector<std::vector<Entry>>& columns, unsigned nRows, const std::vector<bool>& skip, unsigned long long& additions, unsigned threads = 1, const Column& prototype = Column()){
+	unsigned n = columns.size();
+	std::vector<unsigned> low(n, noSimplex);
+	std::vector<unsigned> pivotOf(nRows, noSimplex);		//Row -> column with that low
+	auto skipped = [&](unsigned j){ return j < skip.size() && skip[j]; };
+
+	//Reduce one column against pivotOf; returns its low
+	auto reduce = [&](Column& work, unsigned j){
+		work.load(columns[j]);
+		unsigned ret = work.pivot();
+		while(ret != noSimplex && pivotOf[ret] != noSimplex){
+			work.add(columns[pivotOf[ret]]);
+			additions++;
+			ret = work.pivot();
+		}
+		work.store(columns[j]);
+		return ret;
+	};
+
+	unsigned chunkSize = std::max<unsigned>(256, (n + 4 * threads - 1) / std::max<unsigned>(1, 4 * threads));
+	unsigned chunkCount = (n + chunkSize - 1) / chunkSize;
+
+	if(threads <= 1 || chunkCount <= 1){
+		Column work = prototype;
+		work.init(nRows);
+		for(unsigned j = 0; j < n; j++){
+			if(skipped(j)){
+				columns[j].clear();
+				continue;
+			}
+			low[j] = reduce(work, j);
+			if(low[j] != noSimplex)
+				pivotOf[low[j]] = j;
+		}
+		return low;
+	}
+
+	//First row that is local to each chunk (past every row of the columns left of it)
+	std::vector<unsigned> firstLocal(chunkCount, 0);
+	unsigned rowLimit = 0;
+	for(unsigned c = 0; c < chunkCount; c++){
+		firstLocal[c] = rowLimit;
+		for(unsigned j = c * chunkSize; j < std::min(n, (c + 1) * chunkSize); j++){
+			if(skipped(j))
+				columns[j].clear();
+			else if(!columns[j].empty())
+				rowLimit = std::max(rowLimit, entryRow(columns[j].back()) + 1);
+		}
+	}
+
+	//Local phase: chunks are claimed in order by the worker threads
+	std::atomic<unsigned> nextChunk(0);
+	std::vector<std::vector<unsigned>> unresolved(chunkCount);
+	std::vector<unsigned long long> threadAdditions(threads, 0);
+
+	auto worker = [&](unsigned tid){
+		Column work = prototype;
+		work.init(nRows);
+		std::unordered_map<unsigned, unsigned> localPivot;
+
+		for(unsigned c = nextChunk++; c < chunkCount; c = nextChunk++){
+			localPivot.clear();
+			for(unsigned j = c * chunkSize; j < std::min(n, (c + 1) * chunkSize); j++){
+				if(columns[j].empty())
+					continue;
+
+				work.load(columns[j]);
+				unsigned l = work.pivot();
+				while(l != noSimplex && l >= firstLocal[c]){
+					auto pivot = localPivot.find(l);
+					if(pivot == localPivot.end())
+						break;
+					work.add(columns[pivot->second]);
+					threadAdditions[tid]++;
+					l = work.pivot();
+				}
+				work.store(columns[j]);
+
+				if(l == noSimplex)
+					continue;
+				if(l >= firstLocal[c]){
+					localPivot[l] = j;
+					low[j] = l;
+				} else {
+					unresolved[c].push_back(j);
+				}
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for(unsigned t = 1; t < threads; t++)
+		workers.push_back(std::thread(worker, t));
+	worker(0);
+	for(auto &w : workers)
+		w.join();
+
+	for(auto a : threadAdditions)
+		additions += a;
+
+	//Global phase: the unresolved columns in order, against every pivot found so far
+	for(unsigned j = 0; j < n; j++)
+		if(low[j] != noSimplex)
+			pivotOf[low[j]] = j;
+
+	Column work = prototype;
+	work.init(nRows);
+	for(auto& chunk : unresolved){
+		for(auto j : chunk){
+			low[j] = reduce(work, j);
+			if(low[j] != noSimplex)
+				pivotOf[low[j]] = j;
+		}
+	}
+
+	return low;
+}
+
+// Column reduction with the working column representation named by columnType
+//		(vector, heap, bit_tree or full)
+inline std::vector<unsigned> reduceColumns(std::vector<std::vector<unsigned>>& columns, unsigned nRows, const std::vector<bool>& skip, unsigned long long& additions, const std::string& columnType, unsigned threads = 1){
+	return dispatchColumn(columnType, [&](auto column){
+		return reduceColumns<decltype(column)>(columns, nRows, skip, additions, threads);
+	});
+}
+
+// Reduce columns over Z/p in a fieldColumn (low = largest row with a non-zero coefficient);
+//		the pivot column is scaled by -c / c' to cancel the low entry
+inline std::vector<unsigned> reduceColumns(std::vector<std::vector<fieldEntry>>& columns, unsigned nRows, const std::vector<bool>& skip, unsigned long long& additions, const primeField& field, unsigned threads = 1){
+	return reduceColumns<fieldColumn>(columns, nRows, skip, additions, threads, fieldColumn(field));
+}
+
+// Leave the rows flagged in merged out of each column
+template<typename Entry>
+void compressRows(std::vector<std::vector<Entry>>& columns, const std::vector<bool>& merged){
+	if(merged.empty())
+		return;
+	for(auto& column : columns)
+		column.erase(std::remove_if(column.begin(), column.end(), [&](const Entry& entry){ return entryRow(entry) < merged.size() && merged[entryRow(entry)]; }), column.end());
+}
+
+// Rows of the reduced columns, as kept in reducedBoundary
+inline void keepRows(std::vector<std::vector<unsigned>>& columns, std::vector<std::vector<unsigned>>& rows){ rows.swap(columns); }
+inline void keepRows(std::vector<std::vector<fieldEntry>>& columns, std::vector<std::vector<unsigned>>& rows){
+	rows.assign(columns.size(), {});
+	for(unsigned j = 0; j < columns.size(); j++)
+		for(auto& entry : columns[j])
+			rows[j].push_back(entry.row);
+}
+
+// Reduce the boundary matrices of dimensions top down to bottom (>= 1) with clearing;
+//		reduce(nChain, pChain, clear, additions, columns) reduces one boundary matrix of Entry
+//		columns, leaving the reduced columns in columns, and returns the lows
+template<typename Entry, typename Chain, typename Reduce>
+reducedBoundary clearingReduce(const std::vector<Chain>& chains, unsigned top, unsigned bottom, bool keepColumns, Reduce reduce){
+	reducedBoundary ret;
+	if(chains.empty())
+		return ret;
+	top = std::min<unsigned>(top, chains.size() - 1);
+	bottom = std::max<unsigned>(bottom, 1);
+
+	ret.low.resize(top + 1);
+	if(keepColumns)
+		ret.columns.resize(top + 1);
+
+	std::vector<bool> clear;
+	for(unsigned d = top; d >= bottom; d--){
+		auto& pChain = chains[d];
+		auto& nChain = chains[d-1];
+
+		std::vector<std::vector<Entry>> boundary;
+		for(auto c : clear)
+			ret.cleared += c;
+
+		ret.low[d] = reduce(nChain, pChain, clear, ret.additions, boundary);
+
+		std::vector<bool> nextClear(nChain.size(), false);
+		for(auto l : ret.low[d])
+			if(l != noSimplex)
+				nextClear[l] = true;
+
+		clear.swap(nextClear);
+		if(keepColumns)
+			keepRows(boundary, ret.columns[d]);
+		if(d == bottom)
+			break;
+	}
+
+	return ret;
+}
+
+// Twist reduction over Z2 in a working column of type Column
+//		merged flags the union-find merge edges (see zeroPersistence); they are never the pivot
+//		of a triangle, so their rows are left out of the triangle boundaries (compression,
+//		see Bauer-Kerber-Reininghaus-14)
+template<typename Column, typename Chain>
+reducedBoundary twistReduce(const std::vector<Chain>& chains, unsigned top, unsigned bottom, bool keepColumns, unsigned threads = 1, const std::vector<bool>& merged = {}){
+	return clearingReduce<unsigned>(chains, top, bottom, keepColumns, [&](const Chain& nChain, const Chain& pChain, const std::vector<bool>& clear, unsigned long long& additions, std::vector<std::vector<unsigned>>& rows){
+		rows = boundaryColumns(nChain, pChain);
+		if(&nChain == &chains[1])
+			compressRows(rows, merged);
+		return reduceColumns<Column>(rows, nChain.size(), clear, additions, threads);
+	});
+}
+
+// Twist reduction with the working column representation named by columnType
+//		(vector, heap, bit_tree or full)
+template<typename Chain>
+reducedBoundary twistReduce(const std::vector<Chain>& chains, unsigned top, unsigned bottom, bool keepColumns, const std::string& columnType = "vector", unsigned threads = 1, const std::vector<bool>& merged = {}){
+	return dispatchColumn(columnType, [&](auto column){
+		return twistReduce<decltype(column)>(chains, top, bottom, keepColumns, threads, merged);
+	});
+}
+
+// Twist reduction over the coefficient field; Z2 keeps the column type above, Z/p reduces
+//		signed columns in a fieldColumn (kept columns hold their rows only)
+template<typename Chain>
+reducedBoundary twistReduce(const std::vector<Chain>& chains, unsigned top, unsigned bottom, bool keepColumns, const primeField& field, const std::string& columnType = "vector", unsigned threads = 1, const std::vector<bool>& merged = {}){
+	if(field.characteristic() == 2)
+		return twistReduce(chains, top, bottom, keepColumns, columnType, threads, merged);
+
+	return clearingReduce<fieldEntry>(chains, top, bottom, keepColumns, [&](const Chain& nChain, const Chain& pChain, const std::vector<bool>& clear, unsigned long long& additions, std::vector<std::vector<fieldEntry>>& columns){
+		columns = boundaryColumns(nChain, pChain, field);
+		if(&nChain == &chains[1])
+			compressRows(columns, merged);
+		return reduceColumns(columns, nChain.size(), clear, additions, field, threads);
+	});
+}
+
+// Persistence pairs up to dimension top, positions flattened over chains (dimension by
+//		dimension): each negative simplex -> the positive simplex it kills. Edges come from
+//		union-find (mapped to noSimplex), higher dimensions from twist reduction. The merge
+//		edges are never the pivot of a triangle, so their rows are left out of the triangle
+//		boundaries (compression, see Bauer-Kerber-Reininghaus-14); this also keeps complexes
+//		coreduced by simplexCoreduction.hpp consistent. Without clearing each dimension is
+//		reduced on its own (same pairs). Columns above the edges are reduced over field.
+template<typename Chain>
+std::map<unsigned, unsigned> simplexPairs(const std::vector<Chain>& chains, unsigned top, const std::string& columnType = "vector", unsigned threads = 1, bool clearing = true, const primeField& field = primeField()){
+	std::map<unsigned, unsigned> ret;
+	if(chains.size() < 2 || top < 1)
+		return ret;
+
+	std::vector<unsigned> offset(chains.size(), 0);
+	for(unsigned d = 1; d < chains.size(); d++)
+		offset[d] = offset[d-1] + chains[d-1].size();
+
+	std::vector<bool> merged(chains[1].size(), false);
+	for(auto merge : zeroPersistence(chains[0], chains[1])){
+		ret[offset[1] + merge.edge] = noSimplex;
+		merged[merge.edge] = true;
+	}
+
+	std::vector<reducedBoundary> passes;
+	if(clearing)
+		passes.push_back(twistReduce(chains, top, 2, false, field, columnType, threads, merged));
+	else for(unsigned d = 2; d <= top && d < chains.size(); d++)
+		passes.push_back(twistReduce(chains, d, d, false, field, columnType, threads, merged));
+
+	for(auto& reduced : passes)
+		for(unsigned d = 2; d < reduced.low.size(); d++)
+			for(unsigned j = 0; j < reduced.low[d].size(); j++)
+				if(reduced.low[d][j] != noSimplex)
+					ret[offset[d] + j] = offset[d-1] + reduced.low[d][j];
+
+	return ret;
+}
+
+// Positions (flattened over chains, dimension by dimension) of the negative simplices
+//		up to dimension top (see simplexPairs)
+template<typename Chain>
+std::set<unsigned> negativeSimplices(const std::vector<Chain>& chains, unsigned top, const std::string& columnType = "vector", unsigned threads = 1, const primeField& field = primeField()){
+	std::set<unsigned> ret;
+	for(auto& pair : simplexPairs(chains, top, columnType, threads, true, field))
+		ret.insert(ret.end(), pair.first);
+	return ret;
+}
+
+#endif
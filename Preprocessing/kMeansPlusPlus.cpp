@@ -15,6 +15,7 @@
 #include <vector>
 #include "kMeansPlusPlus.hpp"
 #include "utils.hpp"
+#include "distanceMetrics.hpp"
 
 // basePipe constructor
 kMeansPlusPlus::kMeansPlusPlus(){
@@ -31,6 +32,15 @@ pipePacket kMeansPlusPlus::runPreprocessor(pipePacket inData){
 		return inData;
 	}
 	
+	//Resolve the metric and dimension once for the clustering loops
+	return dispatchMetric(metric, inData.originalData[0].size(), [&](auto m, auto dim){
+		return this->runClustering<decltype(m), decltype(dim)>(inData);
+	});
+}
+
+// runClustering -> k-means++ under the selected metric / dimension instantiation
+template<class metricT, class dimT>
+pipePacket kMeansPlusPlus::runClustering(pipePacket inData){
     //Arguments - num_clusters, num_iterations
     std::vector<std::vector<double>> centroids;     //Storing centroids
     std::vector<int> labels;                        //Storing labels for mapping data to centroids
@@ -65,8 +75,8 @@ pipePacket kMeansPlusPlus::runPreprocessor(pipePacket inData){
         bool picked = false;
         std::vector<double>  center_next = inData.originalData[index_next];
             for(unsigned j=0; j<inData.originalData.size()-1; j++) {
-                auto dist_next = ut.vectors_distance(inData.originalData[j], center_next);
-                auto centers_dist = ut.vectors_distance(center_initial, center_next);
+                auto dist_next = metricDistance<metricT, dimT>(inData.originalData[j], center_next);
+                auto centers_dist = metricDistance<metricT, dimT>(center_initial, center_next);
                 auto probability = (centers_dist*centers_dist)/dist_next;
                 
                 bool valid_center = (rand() %100) < (probability) * 10;
@@ -118,7 +128,7 @@ pipePacket kMeansPlusPlus::runPreprocessor(pipePacket inData){
 			
 			//Check each centroid for the minimum distance
 			for (unsigned c = 0; c < tempCentroids.size(); c++){
-				auto curDist = ut.vectors_distance(inData.originalData[j], tempCentroids[c]);
+				auto curDist = metricDistance<metricT, dimT>(inData.originalData[j], tempCentroids[c]);
 				
 				
 				if(curDist < minDist){
@@ -187,8 +197,16 @@ bool kMeansPlusPlus::configPreprocessor(std::map<std::string, std::string> confi
 		num_iterations = std::atoi(configMap["iterations"].c_str());
 	else return false;
 	
+	pipe = configMap.find("metric");
+	if(pipe != configMap.end())
+		metric = configMap["metric"];
+	if(!validMetric(metric)){
+		ut.writeError(procName, "Unknown metric: " + metric);
+		return false;
+	}
+	
 	configured = true;
-	ut.writeDebug("StreamKMeans","Configured with parameters { clusters: " + configMap["clusters"] + ", iterations: " + configMap["iterations"] + ", debug: " + strDebug + ", outputFile: " + outputFile + " }");
+	ut.writeDebug("StreamKMeans","Configured with parameters { clusters: " + configMap["clusters"] + ", iterations: " + configMap["iterations"] + ", metric: " + metric + ", debug: " + strDebug + ", outputFile: " + outputFile + " }");
 
 	return true;
 }
@@ -8,6 +8,7 @@ class kMeansPlusPlus : public preprocessor {
   private:
 	int num_clusters;			
 	int num_iterations;			
+	template<class metricT, class dimT> pipePacket runClustering(pipePacket inData);
   public:
 	kMeansPlusPlus();
     pipePacket runPreprocessor(pipePacket inData);
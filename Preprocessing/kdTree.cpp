@@ -7,6 +7,7 @@
 #include <fstream>
 #include <algorithm>
 #include <cstdlib>
+#include <cmath>
 #include <limits>
 #include <random>
 #include <chrono>
@@ -201,7 +202,7 @@ kdNodePtr kdTree::findNearest(const kdNodePtr &branch, const point &pt, const si
         }
     }
 
-    if(abs(dx) < bestDistL){
+    if(std::fabs(dx) < bestDistL){
         further = findNearest(other, pt, nextLv, bestL, bestDistL);
         if(!further->x.empty()){
             double dl = ut.vectors_distance(further->x, pt);
@@ -245,8 +246,9 @@ pointIndexArr kdTree::neighborhood(const kdNodePtr &branch, const point &pt, con
     }  //check for empty branch
 
     size_t dim = pt.size();
-    d = ut.vectors_distance(point(*branch), pt);
-    dx = point(*branch).at(level) - pt.at(level);
+    const point &x = branch->x; //Avoid copying the node's point
+    d = ut.vectors_distance(x, pt);
+    dx = x.at(level) - pt.at(level);
 
     pointIndexArr nbh, nbh_s, nbh_o;
     if (d <= rad) {
@@ -268,7 +270,7 @@ pointIndexArr kdTree::neighborhood(const kdNodePtr &branch, const point &pt, con
 
     nbh_s = neighborhood(section, pt, rad, (level +1) % dim);
     nbh.insert(nbh.end(), nbh_s.begin(), nbh_s.end()); //Add points in neighborhood from that branch
-    if(abs(dx) < rad){ //Points in other branch may also be contained in neighborhood
+    if(std::fabs(dx) <= rad){ //Points in other branch may also be contained in neighborhood
         nbh_o = neighborhood(other, pt, rad, (level+1)% dim);
         nbh.insert(nbh.end(), nbh_o.begin(), nbh_o.end());
     }
@@ -11,6 +11,7 @@ class preprocessor {
 	std::string procName = "preprocessor";
 	int debug;
 	std::string outputFile;
+	std::string metric = "euclidean";
 	utils ut;
     preprocessor();
     preprocessor* newPreprocessor(const std::string&);
@@ -17,6 +17,7 @@
 #include "streamingKmeans.hpp"
 #include "streamingUtils.hpp"
 #include "utils.hpp"
+#include "distanceMetrics.hpp"
 // overall goal: get weighted representation of streaming data, then perform k means on that .... Shindler 11
 
 // basePipe constructor
@@ -35,6 +36,16 @@ pipePacket streamingKmeans::runPreprocessor(pipePacket inData){
 		return inData;
 	}
 	
+	//Resolve the metric and dimension once for the streaming loops
+	return dispatchMetric(metric, inData.originalData[0].size(), [&](auto m, auto dim){
+		return this->runStreaming<decltype(m), decltype(dim)>(inData);
+	});
+}
+
+// runStreaming -> streaming k-means under the selected metric / dimension instantiation
+template<class metricT, class dimT>
+pipePacket streamingKmeans::runStreaming(pipePacket inData){
+	
 	//Arguments - num_clusters, num_iterations
 
   int numClusters = 20;
@@ -107,7 +118,7 @@ std::vector<std::vector<double>> summedCentroidVectors(numClusters, std::vector<
 				if (facilities.size() <= maxFacilities){   //first phase goes immediately to reassigning
 				 		std::vector<double> y = approxNearestNeighbor(facilities, sortedApproxFacils, omega,  x,  approxSize, pipePacket(inData));
 				//		std::cout<< y[0] << "  <-y value \n";
-			      double delta = ut.vectors_distance(inData.originalData[x], y); 	//measure delta = min d(x,y)^2 --> using approx nearest neighbor to get y
+			      double delta = metricDistance<metricT, dimT>(inData.originalData[x], y); 	//measure delta = min d(x,y)^2 --> using approx nearest neighbor to get y
 			//			std::cout<< inData.originalData[x][0] << inData.originalData[x][1] << " <-current point\n";
 			//			std::cout<< delta << " <-delta value \n";
 			//			std::cout<< f << " <-f value is \n";
@@ -130,7 +141,7 @@ std::vector<std::vector<double>> summedCentroidVectors(numClusters, std::vector<
 										double minDist = std::numeric_limits<double>::max();
 										for(unsigned c = 0; c<numFacilities; c++){
 											// clusterIndex = 0;
-											double curDist = ut.vectors_distance(inData.originalData[x], facilities[c]);
+											double curDist = metricDistance<metricT, dimT>(inData.originalData[x], facilities[c]);
 												if(curDist < minDist) {
 													minDist = curDist;
 													clustered.push_back(std::make_pair(inData.originalData[x], c));
@@ -201,7 +212,7 @@ std::vector<std::vector<double>> summedCentroidVectors(numClusters, std::vector<
 										// 	summedCentroidVectors.clear();
 								//			sortedApproxFacilsHat.clear();
 							//			 std::cout<< yHat[0] << " <-yhat\n";
-							       double deltaHat = ut.vectors_distance(summedCentroidVectors[xHat], yHat); 
+							       double deltaHat = metricDistance<metricT, dimT>(summedCentroidVectors[xHat], yHat); 
                          if(prob((weight[xHat]*deltaHat)/f)){   //add old facility to weighted facility set if weight is high enough
 									          kHat.push_back(summedCentroidVectors[xHat]);
 								 			   }
@@ -210,7 +221,7 @@ std::vector<std::vector<double>> summedCentroidVectors(numClusters, std::vector<
 															double minDist = std::numeric_limits<double>::max();
 														for(unsigned x = 0; x<summedCentroidVectors.size(); x++){
 															for(unsigned k = 0; k<kHat.size(); k++){
-																	double curDist = ut.vectors_distance(summedCentroidVectors[x], kHat[k]);
+																	double curDist = metricDistance<metricT, dimT>(summedCentroidVectors[x], kHat[k]);
 																		if(curDist < minDist) {
 																			minDist = curDist;
 																		}
@@ -323,8 +334,16 @@ bool streamingKmeans::configPreprocessor(std::map<std::string, std::string> conf
 		num_iterations = std::atoi(configMap["iterations"].c_str());
 	else return false;	
 	
+	pipe = configMap.find("metric");
+	if(pipe != configMap.end())
+		metric = configMap["metric"];
+	if(!validMetric(metric)){
+		ut.writeError(procName, "Unknown metric: " + metric);
+		return false;
+	}
+	
 	configured = true;
-	ut.writeDebug("StreamKMeans","Configured with parameters { clusters: " + configMap["clusters"] + ", iterations: " + configMap["iterations"] + ", debug: " + strDebug + ", outputFile: " + outputFile + " }");
+	ut.writeDebug("StreamKMeans","Configured with parameters { clusters: " + configMap["clusters"] + ", iterations: " + configMap["iterations"] + ", metric: " + metric + ", debug: " + strDebug + ", outputFile: " + outputFile + " }");
 	
 	return true;
 }
@@ -343,20 +362,20 @@ std::vector<double> streamingKmeans::approxNearestNeighbor(std::vector<std::vect
 	
 	if(loc == -1){
 		//nearest centroid is current one
-		 squareDist = ut.vectors_distance(inData.originalData[x], facilities[sortedApproxFacils[0].second] ); 
+		 squareDist = metricDistance(metric, inData.originalData[x], facilities[sortedApproxFacils[0].second] ); 
 //		 std::cout<<squareDist<< " <-squareDist x\n";
 		return inData.originalData[x];  
 	}
 	else if (loc == x-1){
-		double squareDist =  ut.vectors_distance(inData.originalData[x], facilities[sortedApproxFacils[size-1].second]);
+		double squareDist =  metricDistance(metric, inData.originalData[x], facilities[sortedApproxFacils[size-1].second]);
 //		std::cout<<squareDist<< " <-squareDist x-1\n";
 		return facilities[sortedApproxFacils[size-1].second];
 	}
  
 	
-	squareDist = ut.vectors_distance(inData.originalData[x], facilities[sortedApproxFacils[loc].second] );
+	squareDist = metricDistance(metric, inData.originalData[x], facilities[sortedApproxFacils[loc].second] );
 //	std::cout<<squareDist<< " <-squareDist ==0\n";
-	double dist = ut.vectors_distance(inData.originalData[x], facilities[sortedApproxFacils[loc + 1].second]);
+	double dist = metricDistance(metric, inData.originalData[x], facilities[sortedApproxFacils[loc + 1].second]);
 //	std::cout<<dist<< " <-Dist \n";
   if(squareDist <= dist){
 		return facilities[sortedApproxFacils[loc].second];
@@ -382,25 +401,25 @@ std::vector<double> streamingKmeans::approxHat(std::vector<std::vector<double>>&
 //	std::cout<<"got to approxHat start \n";
 	if(loc == -1){
 		//nearest centroid is current one
-		 squareDist = ut.vectors_distance(summedCentroidVectors[xHat], summedCentroidVectors[sortedApproxFacilsHat[0].second] ); 
+		 squareDist = metricDistance(metric, summedCentroidVectors[xHat], summedCentroidVectors[sortedApproxFacilsHat[0].second] ); 
 //		 std::cout<<squareDist<< " <-squareDist x\n";
 //std::cout<<"got to 1\n";
 		return summedCentroidVectors[xHat];  
 	}
 	else if (loc == xHat-1){
-		double squareDist =  ut.vectors_distance(summedCentroidVectors[xHat], summedCentroidVectors[sortedApproxFacilsHat[size-1].second]);
+		double squareDist =  metricDistance(metric, summedCentroidVectors[xHat], summedCentroidVectors[sortedApproxFacilsHat[size-1].second]);
 //		std::cout<<squareDist<< " <-squareDist x-1\n";
 //std::cout<<"got to 2\n";
 		return summedCentroidVectors[sortedApproxFacilsHat[size-1].second];
 	}
  
 
-	squareDist = ut.vectors_distance(summedCentroidVectors[xHat], summedCentroidVectors[sortedApproxFacilsHat[loc].second] );
+	squareDist = metricDistance(metric, summedCentroidVectors[xHat], summedCentroidVectors[sortedApproxFacilsHat[loc].second] );
 //	std::cout<<squareDist<< " <-squareDist ==0\n";
 
  //std::cout<<sortedApproxFacilsHat[2].first << " sanity check \n";
 // std::cout<<summedCentroidVectors[2][0]<< " sanity check \n";
-	double dist = ut.vectors_distance(summedCentroidVectors[xHat], summedCentroidVectors[sortedApproxFacilsHat[loc + 1].second]);
+	double dist = metricDistance(metric, summedCentroidVectors[xHat], summedCentroidVectors[sortedApproxFacilsHat[loc + 1].second]);
 
 //	std::cout<<dist<< " <-Dist \n";
   if(squareDist <= dist){
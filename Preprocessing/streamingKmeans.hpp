@@ -8,6 +8,7 @@ class streamingKmeans : public preprocessor {
   private:
 	int numClusters;			
 	int num_iterations;		
+	template<class metricT, class dimT> pipePacket runStreaming(pipePacket inData);
   	
   public:
 	streamingKmeans();
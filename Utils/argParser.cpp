@@ -9,8 +9,8 @@
 #include <iostream>
 #include "argParser.hpp"
 
-std::map<std::string, std::string> argMap = { {"mpi","a"},{"mode","m"},{"dimensions","d"},{"iterations","r"},{"pipeline","p"},{"inputFile","i"},{"outputFile","o"},{"epsilon","e"},{"lambda","l"},{"debug","x"},{"complexType","c"},{"clusters","k"},{"preprocessor","pre"},{"upscale","u"},{"twist","t"},{"collapse","z"}};
-std::map<std::string, std::string> defaultMap = { {"mpi", "0"},{"mode", "standard"},{"dimensions","1"},{"iterations","250"},{"pipeline",""},{"inputFile","None"},{"outputFile","output.csv"},{"epsilon","5"},{"lambda",".25"},{"debug","0"},{"complexType","simplexTree"},{"clusters","20"},{"preprocessor",""},{"upscale","false"},{"twist","false"},{"collapse","false"}};
+std::map<std::string, std::string> argMap = { {"mpi","a"},{"mode","m"},{"dimensions","d"},{"iterations","r"},{"pipeline","p"},{"inputFile","i"},{"outputFile","o"},{"epsilon","e"},{"lambda","l"},{"debug","x"},{"complexType","c"},{"clusters","k"},{"preprocessor","pre"},{"upscale","u"},{"twist","t"},{"columnType","ct"},{"coeff","cf"},{"minPersistence","mp"},{"collapse","z"},{"threads","th"},{"sparse","sp"},{"edgeCollapse","ec"},{"metric","dm"},{"inputFormat","if"},{"cacheDir","cd"},{"precision","pr"}};
+std::map<std::string, std::string> defaultMap = { {"mpi", "0"},{"mode", "standard"},{"dimensions","1"},{"iterations","250"},{"pipeline",""},{"inputFile","None"},{"outputFile","output.csv"},{"epsilon","5"},{"lambda",".25"},{"debug","0"},{"complexType","simplexTree"},{"clusters","20"},{"preprocessor",""},{"upscale","false"},{"twist","false"},{"columnType","vector"},{"coeff","2"},{"minPersistence","0"},{"collapse","false"},{"threads","1"},{"sparse","false"},{"edgeCollapse","false"},{"metric","euclidean"},{"inputFormat","pointcloud"},{"cacheDir",""},{"precision","double"}};
 
 // argParse constructor, currently no needed information for the class constructor
 argParser::argParser(){
@@ -49,6 +49,18 @@ void argParser::printUsage(){
 	std::cout << "\t -i,--inputFile <filename>" << std::endl;
 	std::cout << "\t\tFilename (csv) for LHF input"  << std::endl;
 	std::cout << std::endl; 
+	std::cout << "\t -if,--inputFormat (pointcloud|distmatrix|edgelist)" << std::endl;
+	std::cout << "\t\tInput file holds point coordinates, a distance matrix or a weighted edge list (i,j,w)" << std::endl;
+	std::cout << "\t\tdefault: pointcloud" << std::endl;
+	std::cout << std::endl; 
+	std::cout << "\t -cd,--cacheDir <directory>" << std::endl;
+	std::cout << "\t\tReuse distance matrices cached in this directory (keyed by input, metric and epsilon)" << std::endl;
+	std::cout << "\t\tdefault: disabled" << std::endl;
+	std::cout << std::endl; 
+	std::cout << "\t -pr,--precision (double|float|rank16|rank32)" << std::endl;
+	std::cout << "\t\tStorage of the distance matrix; rank16/32 hold exact ranks of the values under epsilon" << std::endl;
+	std::cout << "\t\tdefault: double" << std::endl;
+	std::cout << std::endl; 
 	std::cout << "\t -o,--outputFile <filename>" << std::endl;
 	std::cout << "\t\tFilename for LHF output" << std::endl;
 	std::cout << std::endl; 
@@ -60,7 +72,7 @@ void argParser::printUsage(){
 	std::cout << "\t\tDecay factor lambda for DenStream" << std::endl;
 	std::cout << "\t\tdefault: .25" << std::endl;
 	std::cout << std::endl;
-	std::cout << "\t -m,--mode (standard|reduced|upscale|sw)" << std::endl;
+	std::cout << "\t -m,--mode (standard|reduced|upscale|sw|implicit|lockfree)" << std::endl;
 	std::cout << "\t\tSets the mode for LHF to run in" << std::endl;
 	std::cout << "\t\t\tdefault: standard" << std::endl;
 	std::cout << std::endl;
@@ -68,6 +80,43 @@ void argParser::printUsage(){
 	std::cout << "\t\tSets the maximum homology dimension to compute (H_d)" << std::endl;
 	std::cout << "\t\t\tdefault: 1" << std::endl;
 	std::cout << std::endl;
+	std::cout << "\t -t,--twist (true|false)" << std::endl;
+	std::cout << "\t\tReduce from the top dimension down, clearing columns paired one dimension up" << std::endl;
+	std::cout << "\t\t\tdefault: false" << std::endl;
+	std::cout << std::endl;
+	std::cout << "\t -ct,--columnType (vector|heap|bit_tree|full)" << std::endl;
+	std::cout << "\t\tWorking column representation for boundary matrix reduction" << std::endl;
+	std::cout << "\t\t\tdefault: vector" << std::endl;
+	std::cout << std::endl;
+	std::cout << "\t -cf,--coeff <prime>" << std::endl;
+	std::cout << "\t\tCoefficient field Z/p for the persistence reduction (fastPersistence, persistence with twist or indSimplexTree); other persistence stages require 2" << std::endl;
+	std::cout << "\t\t\tdefault: 2" << std::endl;
+	std::cout << std::endl;
+	std::cout << "\t -mp,--minPersistence <double>" << std::endl;
+	std::cout << "\t\tDrop intervals with persistence (death - birth) below this value" << std::endl;
+	std::cout << "\t\t\tdefault: 0" << std::endl;
+	std::cout << std::endl;
+	std::cout << "\t -th,--threads <int>" << std::endl;
+	std::cout << "\t\tNumber of threads for multithreaded pipeline stages (distances, rips expansion, chunked and lock-free reduction)" << std::endl;
+	std::cout << "\t\t\tdefault: 1" << std::endl;
+	std::cout << std::endl;
+	std::cout << "\t -sp,--sparse (true|false)" << std::endl;
+	std::cout << "\t\tBuild a sparse epsilon-neighborhood graph instead of the distance matrix" << std::endl;
+	std::cout << "\t\t\tdefault: false" << std::endl;
+	std::cout << std::endl;
+	std::cout << "\t -ec,--edgeCollapse (true|false)" << std::endl;
+	std::cout << "\t\tCollapse dominated edges of the neighborhood graph before the complex is built" << std::endl;
+	std::cout << "\t\t\tdefault: false" << std::endl;
+	std::cout << std::endl;
+	std::cout << "\t -z,--collapse (true|false)" << std::endl;
+	std::cout << "\t\tRemove free face pairs entering at the same filtration value after the rips expansion" << std::endl;
+	std::cout << "\t\t\tindSimplexTree also drops coreduction pairs from the graph its persistence reduces" << std::endl;
+	std::cout << "\t\t\tdefault: false" << std::endl;
+	std::cout << std::endl;
+	std::cout << "\t -dm,--metric (euclidean|sqeuclidean|manhattan|chebyshev|cosine)" << std::endl;
+	std::cout << "\t\tDistance metric for the distance stages and clustering" << std::endl;
+	std::cout << "\t\t\tdefault: euclidean" << std::endl;
+	std::cout << std::endl;
 	
 	return;
 }
@@ -108,7 +157,9 @@ void argParser::printArguments(std::map<std::string,std::string> args){
 	return;
 }
 
-void argParser::setPipeline(std::map<std::string, std::string>& args){
+// argParser::setPipeline -> Fill in the pipeline for the mode and options
+//		Returns false if the options can not be run by the pipeline
+bool argParser::setPipeline(std::map<std::string, std::string>& args){
 	if(args["mpi"] == "1"){
 		//Set up our pipeline
 		args["pipeline"] = "distMatrix.neighGraph.rips.fastPersistence";
@@ -144,6 +195,13 @@ void argParser::setPipeline(std::map<std::string, std::string>& args){
 			args["pipeline"] = "distMatrix.neighGraph.rips.fastPersistence";
 			args["upscale"] = "false";
 			args["complexType"] = "simplexTree";
+		} else if(args["mode"] == "implicit"){
+			args["pipeline"] = "distMatrix.implicitPersistence";
+			args["upscale"] = "false";
+		} else if(args["mode"] == "lockfree"){
+			args["pipeline"] = "distMatrix.neighGraph.rips.lockFreePersistence";
+			args["upscale"] = "false";
+			args["complexType"] = "simplexTree";
 		} else if(args["mode"] == "naive" || args["mode"] == "naivewindow"){
 			args["preprocessor"] = "";
 			args["pipeline"] = "naivewindow";
@@ -152,7 +210,42 @@ void argParser::setPipeline(std::map<std::string, std::string>& args){
 		}
 	}
 	
-	return;
+	//Precomputed distances are loaded straight into the complex, drop the distance stage
+	if(args["inputFormat"] == "distmatrix" || args["inputFormat"] == "edgelist"){
+		for(std::string stage : {"distMatrix.", "sparseNeighborhood."}){
+			if(args["pipeline"].compare(0, stage.size(), stage) == 0)
+				args["pipeline"] = args["pipeline"].substr(stage.size());
+		}
+	}
+	
+	//Swap the dense distance matrix for the sparse neighborhood graph
+	if(args["sparse"] == "true" && args["pipeline"].compare(0, 11, "distMatrix.") == 0)
+		args["pipeline"] = "sparseNeighborhood" + args["pipeline"].substr(10);
+	
+	//Collapse the neighborhood graph ahead of the complex construction (and expansion)
+	auto neighGraph = args["pipeline"].find("neighGraph");
+	if(args["edgeCollapse"] == "true" && neighGraph != std::string::npos)
+		args["pipeline"].insert(neighGraph, "edgeCollapse.");
+	
+	//fastPersistence and the twistReduce path of persistence reduce over Z/p; the other
+	//		persistence stages are Z2 only
+	if(args["coeff"] != "2"){
+		bool sparsePersistence = args["twist"] == "true" || args["complexType"] == "indSimplexTree";
+		std::string stages = args["pipeline"] + ".";
+		for(size_t start = 0, end; (end = stages.find('.', start)) != std::string::npos; start = end + 1){
+			std::string stage = stages.substr(start, end - start);
+			if(stage == "persistence" && sparsePersistence)
+				continue;
+			for(std::string z2Stage : {"persistence", "boundary", "implicitPersistence", "implicit", "lockFreePersistence", "lockfree", "slidingwindow", "sliding"}){
+				if(stage == z2Stage){
+					std::cout << "LHF : coeff " << args["coeff"] << " is only supported by fastPersistence and persistence with twist (or indSimplexTree), not the " << stage << " stage of " << args["pipeline"] << std::endl;
+					return false;
+				}
+			}
+		}
+	}
+	
+	return true;
 }
 
 
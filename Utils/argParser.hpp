@@ -11,6 +11,6 @@ class argParser {
 	void printArguments(std::map<std::string,std::string>);
     std::map<std::string, std::string> parse(int argc, char** argv);
     std::map<std::string, std::string> defaultArguments(std::map<std::string, std::string>  &map);
-    void setPipeline(std::map<std::string, std::string>&);
+    bool setPipeline(std::map<std::string, std::string>&);
 };
 
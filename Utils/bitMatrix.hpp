@@ -0,0 +1,220 @@
+#pragma once
+
+#ifndef BITMATRIX_HPP_INCL
+#define BITMATRIX_HPP_INCL
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+//x86 builds not compiled for AVX2 / POPCNT (LHF_NATIVE_ARCH off) pick those paths at runtime
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && (!defined(__AVX2__) || !defined(__POPCNT__))
+#define BITMATRIX_DISPATCH 1
+#else
+#define BITMATRIX_DISPATCH 0
+#endif
+
+// Header only Z2 matrix, one bit per entry
+//		Rows are packed 64 entries to a word and padded to 256 bit (32 byte aligned)
+//		blocks, so adding one row to another is a run of AVX2 (or scalar 64 bit) XORs.
+//		Leading / trailing entries are found with count leading / trailing zeros and
+//		row weights with popcount.
+
+// Allocator returning storage aligned to A bytes
+template<typename T, size_t A>
+struct alignedAllocator {
+	typedef T value_type;
+	template<typename U> struct rebind { typedef alignedAllocator<U, A> other; };
+
+	alignedAllocator(){};
+	template<typename U> alignedAllocator(const alignedAllocator<U, A>&){};
+
+	T* allocate(size_t n){
+		void* p = nullptr;
+		if(posix_memalign(&p, A, std::max<size_t>(n * sizeof(T), A)) != 0)
+			throw std::bad_alloc();
+		return static_cast<T*>(p);
+	};
+	void deallocate(T* p, size_t){ free(p); };
+
+	template<typename U> bool operator==(const alignedAllocator<U, A>&) const { return true; };
+	template<typename U> bool operator!=(const alignedAllocator<U, A>&) const { return false; };
+};
+
+
+class bitMatrix {
+  public:
+	typedef unsigned long long word;
+	static const unsigned wordBits = 64;
+	static const unsigned blockWords = 4;					//Words per 256 bit block
+
+  private:
+	std::vector<word, alignedAllocator<word, 32>> data;
+	unsigned nRows = 0;
+	unsigned nCols = 0;
+	unsigned stride = 0;									//Words per row, a multiple of blockWords
+
+	word* row(unsigned r){ return data.data() + (size_t)r * stride; };
+	const word* row(unsigned r) const { return data.data() + (size_t)r * stride; };
+
+#if BITMATRIX_DISPATCH
+	// CPU features, checked once
+	static bool cpuAVX2(){ static const bool ret = __builtin_cpu_supports("avx2"); return ret; };
+	static bool cpuPopcnt(){ static const bool ret = __builtin_cpu_supports("popcnt"); return ret; };
+
+	__attribute__((target("avx2")))
+	static void xorAVX2(word* d, const word* s, unsigned k, unsigned stride){
+		for(; k < stride; k += blockWords){
+			__m256i x = _mm256_xor_si256(_mm256_load_si256((const __m256i*)(d + k)), _mm256_load_si256((const __m256i*)(s + k)));
+			_mm256_store_si256((__m256i*)(d + k), x);
+		}
+	};
+
+	__attribute__((target("popcnt")))
+	static unsigned countPopcnt(const word* d, unsigned stride){
+		unsigned ret = 0;
+		for(unsigned k = 0; k < stride; k++)
+			ret += __builtin_popcountll(d[k]);
+		return ret;
+	};
+#endif
+
+  public:
+	bitMatrix(){};
+	bitMatrix(unsigned rows, unsigned cols){ resize(rows, cols); };
+
+	// Zero matrix of rows x cols
+	void resize(unsigned rows, unsigned cols){
+		nRows = rows;
+		nCols = cols;
+		stride = ((cols + wordBits * blockWords - 1) / (wordBits * blockWords)) * blockWords;
+		data.assign((size_t)rows * stride, 0);
+	};
+
+	unsigned rows() const { return nRows; };
+	unsigned cols() const { return nCols; };
+
+	bool get(unsigned r, unsigned c) const { return (row(r)[c / wordBits] >> (c % wordBits)) & 1; };
+	void set(unsigned r, unsigned c){ row(r)[c / wordBits] |= (word)1 << (c % wordBits); };
+	void flip(unsigned r, unsigned c){ row(r)[c / wordBits] ^= (word)1 << (c % wordBits); };
+
+	void clearRow(unsigned r){
+		word* d = row(r);
+		for(unsigned k = 0; k < stride; k++)
+			d[k] = 0;
+	};
+
+	// Row dst += row src; entries of both rows before column from are assumed zero
+	void addRow(unsigned dst, unsigned src, unsigned from = 0){
+		word* d = row(dst);
+		const word* s = row(src);
+		unsigned k = (from / (wordBits * blockWords)) * blockWords;
+#if defined(__AVX2__)
+		for(; k < stride; k += blockWords){
+			__m256i x = _mm256_xor_si256(_mm256_load_si256((const __m256i*)(d + k)), _mm256_load_si256((const __m256i*)(s + k)));
+			_mm256_store_si256((__m256i*)(d + k), x);
+		}
+#else
+#if BITMATRIX_DISPATCH
+		if(cpuAVX2()){
+			xorAVX2(d, s, k, stride);
+			return;
+		}
+#endif
+		for(; k < stride; k++)
+			d[k] ^= s[k];
+#endif
+	};
+
+	// First set column at or after from, cols() if none
+	unsigned firstSet(unsigned r, unsigned from = 0) const {
+		if(from >= nCols)
+			return nCols;
+		const word* d = row(r);
+		unsigned k = from / wordBits;
+		word w = d[k] & (~(word)0 << (from % wordBits));
+		while(w == 0){
+			if(++k == stride)
+				return nCols;
+			w = d[k];
+		}
+		return k * wordBits + __builtin_ctzll(w);
+	};
+
+	// Last set column, cols() if the row is zero
+	unsigned lastSet(unsigned r) const {
+		const word* d = row(r);
+		for(unsigned k = stride; k-- > 0;)
+			if(d[k] != 0)
+				return k * wordBits + (wordBits - 1) - __builtin_clzll(d[k]);
+		return nCols;
+	};
+
+	unsigned count(unsigned r) const {
+		const word* d = row(r);
+#if BITMATRIX_DISPATCH && !defined(__POPCNT__)
+		if(cpuPopcnt())
+			return countPopcnt(d, stride);
+#endif
+		unsigned ret = 0;
+		for(unsigned k = 0; k < stride; k++)
+			ret += __builtin_popcountll(d[k]);
+		return ret;
+	};
+
+	bool rowEmpty(unsigned r) const { return firstSet(r) == nCols; };
+
+	// Row as a 0/1 vector (the unpacked boundary matrix layout)
+	std::vector<unsigned> denseRow(unsigned r) const {
+		std::vector<unsigned> ret(nCols, 0);
+		for(unsigned c = firstSet(r); c < nCols; c = firstSet(r, c + 1))
+			ret[c] = 1;
+		return ret;
+	};
+
+	// Column echelon elimination: for each column in order, the first row with a one in that
+	//		column is its pivot; the pivot is added to every later row with a one there and then
+	//		zeroed. onPivot(column, row) is called before the pivot row is used.
+	//		Rows are bucketed by their leading column, so each pivot is found without a scan.
+	template<typename F>
+	void eliminate(F onPivot){
+		std::vector<std::vector<unsigned>> leading(nCols);
+		for(unsigned r = 0; r < nRows; r++){
+			unsigned c = firstSet(r);
+			if(c < nCols)
+				leading[c].push_back(r);
+		}
+
+		for(unsigned c = 0; c < nCols; c++){
+			auto& bucket = leading[c];
+			if(bucket.empty())
+				continue;
+
+			//Rows only enter a bucket before its column is reached; the earliest is the pivot
+			unsigned pivot = bucket[0];
+			for(auto r : bucket)
+				pivot = std::min(pivot, r);
+
+			onPivot(c, pivot);
+
+			for(auto r : bucket){
+				if(r == pivot)
+					continue;
+				addRow(r, pivot, c);
+				unsigned next = firstSet(r, c + 1);
+				if(next < nCols)
+					leading[next].push_back(r);
+			}
+			clearRow(pivot);
+			std::vector<unsigned>().swap(bucket);
+		}
+	};
+};
+
+#endif
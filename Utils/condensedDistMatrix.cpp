@@ -0,0 +1,255 @@
+/*
+ * condensedDistMatrix hpp + cpp define a contiguous, condensed storage
+ * for the symmetric distance matrix of a point cloud. Only the strict
+ * upper triangle is stored (n(n-1)/2 entries) in column-major order,
+ * so the distances from a new point to every existing point form one
+ * contiguous block appended at the end of the store.
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <limits>
+#include "condensedDistMatrix.hpp"
+#include "filtrationValue.hpp"
+
+// Cache file layout: header, entries (condensed triangle), filtration weights
+//		the 32 byte header keeps the doubles aligned in the mapping
+struct distMatrixFileHeader {
+	uint64_t magic;
+	uint64_t n;
+	uint64_t entryCount;
+	uint64_t weightCount;
+};
+static const uint64_t DISTMATRIX_MAGIC = 0x3154414D4446484CULL;	// "LHFDMAT1"
+
+// condensedDistMatrix constructor, empty matrix
+condensedDistMatrix::condensedDistMatrix(){
+
+}
+
+// condensedDistMatrix constructor, allocate the full (zeroed) triangle for n points
+condensedDistMatrix::condensedDistMatrix(unsigned _n){
+	n = _n;
+	entries.assign(n > 1 ? index(0,n) : 0, 0.0);
+}
+
+// Set the distance between points i and j (rounded to the filtration precision)
+void condensedDistMatrix::set(unsigned i, unsigned j, double value){
+	if(i == j)
+		return;
+	detach();
+	if(i > j)
+		std::swap(i, j);
+	entries[index(i,j)] = roundFiltration(value);
+	return;
+}
+
+// Memory used by the stored distances (bytes)
+double condensedDistMatrix::getSize() const{
+	switch(storage){
+		case storeFloat: return floats.size() * sizeof(float);
+		case storeRank16: return ranks16.size() * sizeof(uint16_t) + rankValues.size() * sizeof(double);
+		case storeRank32: return ranks32.size() * sizeof(uint32_t) + rankValues.size() * sizeof(double);
+		default: return entryCount() * sizeof(double);
+	}
+}
+
+// Append a point to the matrix, given its distances to the n existing points
+//		Missing distances (short vector) are stored as 0
+void condensedDistMatrix::appendPoint(const std::vector<double>& distances){
+	size_t count = std::min((size_t)n, distances.size());
+	detach();
+
+	for(size_t k = 0; k < count; k++)
+		entries.push_back(roundFiltration(distances[k]));
+	entries.resize(index(0, n + 1), 0.0);
+	n++;
+
+	return;
+}
+
+// Remove a point from the matrix, compacting the remaining distances in place
+//		O(n^2) - every column after the point shifts down
+void condensedDistMatrix::removePoint(unsigned point){
+	if(point >= n)
+		return;
+	detach();
+
+	size_t write = index(0, point);
+	for(unsigned j = point + 1; j < n; j++){
+		size_t read = index(0, j);
+
+		//Copy the column, skipping the removed row
+		for(unsigned i = 0; i < j; i++){
+			if(i != point)
+				entries[write++] = entries[read + i];
+		}
+	}
+
+	n--;
+	entries.resize(n > 1 ? index(0,n) : 0);
+	return;
+}
+
+// Release the stored distances
+void condensedDistMatrix::clear(){
+	n = 0;
+	std::vector<double>().swap(entries);
+	mapped.reset();
+	mappedCount = 0;
+	
+	storage = storeDouble;
+	std::vector<float>().swap(floats);
+	std::vector<uint16_t>().swap(ranks16);
+	std::vector<uint32_t>().swap(ranks32);
+	std::vector<double>().swap(rankValues);
+	return;
+}
+
+// Copy mapped (read-only) or compacted entries into owned double storage before a write
+void condensedDistMatrix::detach(){
+	if(storage != storeDouble){
+		std::vector<double> expanded(entryCount());
+		for(size_t k = 0; k < expanded.size(); k++)
+			expanded[k] = entry(k);
+		
+		unsigned points = n;
+		clear();
+		n = points;
+		entries.swap(expanded);
+		return;
+	}
+	
+	if(!mapped)
+		return;
+	
+	entries.assign(mapped.get(), mapped.get() + mappedCount);
+	mapped.reset();
+	mappedCount = 0;
+	return;
+}
+
+// Parse a --precision value (double, float, rank16, rank32)
+bool condensedDistMatrix::parseStorage(const std::string& name, valueStorage& mode){
+	if(name == "double") mode = storeDouble;
+	else if(name == "float") mode = storeFloat;
+	else if(name == "rank16") mode = storeRank16;
+	else if(name == "rank32") mode = storeRank32;
+	else return false;
+	
+	return true;
+}
+
+// Convert the stored doubles to a compact representation, returns the storage used
+//		float    - 4 byte entries, values are rounded to single precision
+//		rank16/32 - 2/4 byte ranks into the sorted distinct values below maxEpsilon;
+//			exact for every value that can enter the filtration, values at or beyond
+//			maxEpsilon read back as infinity. rank16 widens to rank32 past 65535 values.
+//		Single precision builds (LHF_FLOAT_FILTRATION) store float instead of double
+condensedDistMatrix::valueStorage condensedDistMatrix::compact(valueStorage mode, double maxEpsilon){
+	if(mode == storeDouble && sizeof(filtrationValue) == sizeof(float))
+		mode = storeFloat;
+	
+	if(mode == storeDouble || storage != storeDouble || n < 2)
+		return storage;
+	
+	const double* values = store();
+	size_t count = entryCount();
+	
+	if(mode == storeFloat){
+		floats.assign(values, values + count);
+	} else {
+		//Distinct filtration values, beyond epsilon shares the final rank
+		for(size_t k = 0; k < count; k++)
+			if(values[k] < maxEpsilon)
+				rankValues.push_back(roundFiltration(values[k]));
+		std::sort(rankValues.begin(), rankValues.end());
+		rankValues.erase(std::unique(rankValues.begin(), rankValues.end()), rankValues.end());
+		rankValues.push_back(std::numeric_limits<double>::infinity());
+		
+		if(mode == storeRank16 && rankValues.size() > 65536)
+			mode = storeRank32;
+		
+		auto rank = [&](double value){
+			return value < maxEpsilon ? std::lower_bound(rankValues.begin(), rankValues.end() - 1, roundFiltration(value)) - rankValues.begin() : rankValues.size() - 1;
+		};
+		
+		if(mode == storeRank16){
+			ranks16.resize(count);
+			for(size_t k = 0; k < count; k++)
+				ranks16[k] = rank(values[k]);
+		} else {
+			ranks32.resize(count);
+			for(size_t k = 0; k < count; k++)
+				ranks32[k] = rank(values[k]);
+		}
+	}
+	
+	std::vector<double>().swap(entries);
+	mapped.reset();
+	mappedCount = 0;
+	storage = mode;
+	return storage;
+}
+
+// Write the matrix and its filtration weights to a binary cache file
+//		Written to a temporary file and renamed, so concurrent runs never map a partial file
+bool condensedDistMatrix::save(const std::string& filename, const std::vector<double>& weights) const{
+	if(storage != storeDouble)
+		return false;
+	
+	std::string tmpName = filename + ".tmp" + std::to_string(getpid());
+	FILE* file = std::fopen(tmpName.c_str(), "wb");
+	if(file == nullptr)
+		return false;
+	
+	distMatrixFileHeader header = {DISTMATRIX_MAGIC, n, entryCount(), weights.size()};
+	bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+		&& std::fwrite(data(), sizeof(double), entryCount(), file) == entryCount()
+		&& std::fwrite(weights.data(), sizeof(double), weights.size(), file) == weights.size();
+	ok = (std::fclose(file) == 0) && ok;
+	
+	if(!ok || std::rename(tmpName.c_str(), filename.c_str()) != 0){
+		std::remove(tmpName.c_str());
+		return false;
+	}
+	return true;
+}
+
+// Map a cache file written by save; entries are paged in on first access
+//		Returns false (matrix unchanged) if the file is missing or malformed
+bool condensedDistMatrix::load(const std::string& filename, std::vector<double>& weights){
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd < 0)
+		return false;
+	
+	struct stat st;
+	distMatrixFileHeader header;
+	if(fstat(fd, &st) != 0 || pread(fd, &header, sizeof(header), 0) != sizeof(header) || header.magic != DISTMATRIX_MAGIC
+		|| header.entryCount != (header.n > 1 ? index(0, header.n) : 0)
+		|| (uint64_t)st.st_size != sizeof(header) + (header.entryCount + header.weightCount) * sizeof(double)){
+		close(fd);
+		return false;
+	}
+	
+	size_t length = st.st_size;
+	void* base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(base == MAP_FAILED)
+		return false;
+	
+	const double* values = (const double*)((const char*)base + sizeof(header));
+	weights.assign(values + header.entryCount, values + header.entryCount + header.weightCount);
+	
+	std::vector<double>().swap(entries);
+	n = header.n;
+	mappedCount = header.entryCount;
+	mapped = std::shared_ptr<const double>(values, [base, length](const double*){ munmap(base, length); });
+	return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#ifndef CONDENSEDDISTMATRIX_HPP_INCL
+#define CONDENSEDDISTMATRIX_HPP_INCL
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+// Header file for condensedDistMatrix class - see condensedDistMatrix.cpp for descriptions
+
+class condensedDistMatrix {
+  public:
+	//Entry storage: full doubles, single precision, or ranks into the sorted distinct
+	//	sub-epsilon values (every value beyond epsilon shares the last, infinite, rank)
+	enum valueStorage { storeDouble, storeFloat, storeRank16, storeRank32 };
+
+  private:
+	unsigned n = 0;
+	std::vector<double> entries;
+	
+	//Read-only entries of a memory-mapped cache file (see load); copied into entries on write
+	std::shared_ptr<const double> mapped;
+	size_t mappedCount = 0;
+	
+	const double* store() const { return mapped ? mapped.get() : entries.data(); };
+	void detach();
+	
+	//Compact storage (see compact); expanded back to doubles on write
+	valueStorage storage = storeDouble;
+	std::vector<float> floats;
+	std::vector<uint16_t> ranks16;
+	std::vector<uint32_t> ranks32;
+	std::vector<double> rankValues;
+
+  public:
+	condensedDistMatrix();
+	condensedDistMatrix(unsigned);
+
+	//Column-major upper triangle; entry (i,j), i < j, is stored at j(j-1)/2 + i
+	static size_t index(unsigned i, unsigned j){ return (size_t)j * (j - 1) / 2 + i; };
+
+	//Stored entry k of the condensed triangle
+	double entry(size_t k) const {
+		if(storage == storeDouble) return store()[k];
+		if(storage == storeFloat) return floats[k];
+		return storage == storeRank16 ? rankValues[ranks16[k]] : rankValues[ranks32[k]];
+	};
+
+	//Symmetric lookup, the diagonal is always 0
+	double operator()(unsigned i, unsigned j) const {
+		if(i == j) return 0;
+		return i < j ? entry(index(i,j)) : entry(index(j,i));
+	};
+
+	void set(unsigned, unsigned, double);
+	unsigned size() const { return n; };
+	bool empty() const { return n == 0; };
+	size_t entryCount() const { return n > 1 ? index(0,n) : 0; };
+	double* column(unsigned j){ detach(); return entries.data() + index(0,j); };
+	const double* data() const { return storage == storeDouble ? store() : nullptr; };
+	valueStorage getStorage() const { return storage; };
+	bool isMapped() const { return (bool)mapped; };
+	double getSize() const;
+	
+	bool save(const std::string&, const std::vector<double>&) const;
+	bool load(const std::string&, std::vector<double>&);
+	
+	static bool parseStorage(const std::string&, valueStorage&);
+	valueStorage compact(valueStorage, double);
+
+	void appendPoint(const std::vector<double>&);
+	void removePoint(unsigned);
+	void clear();
+};
+
+#endif
@@ -0,0 +1,373 @@
+#pragma once
+
+#ifndef DISTANCEMETRICS_HPP_INCL
+#define DISTANCEMETRICS_HPP_INCL
+
+/*
+ * distanceMetrics hpp defines compile-time distance metric policies
+ * (euclidean, sqeuclidean, manhattan, chebyshev, cosine) over contiguous
+ * double buffers. Kernels are fully unrolled for fixed dimensions (2, 3,
+ * 8, 16) and use SSE2 / AVX2 for the general case. dispatchMetric selects
+ * the instantiation once per stage so the per-pair loop has no virtual
+ * call or branch on the metric.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Dimension tag, 0 selects the general (runtime dimension) kernels
+template<unsigned D>
+using dimTag = std::integral_constant<unsigned, D>;
+
+// Reduction kernels for a fixed dimension D
+template<unsigned D>
+struct metricKernels {
+	static double dot(const double* a, const double* b, unsigned){
+		double s = 0;
+		for(unsigned k = 0; k < D; k++)
+			s += a[k] * b[k];
+		return s;
+	}
+
+	static double sqDist(const double* a, const double* b, unsigned){
+		double s = 0;
+		for(unsigned k = 0; k < D; k++)
+			s += (a[k] - b[k]) * (a[k] - b[k]);
+		return s;
+	}
+
+	static double absDist(const double* a, const double* b, unsigned){
+		double s = 0;
+		for(unsigned k = 0; k < D; k++)
+			s += std::fabs(a[k] - b[k]);
+		return s;
+	}
+
+	static double maxDist(const double* a, const double* b, unsigned){
+		double s = 0;
+		for(unsigned k = 0; k < D; k++)
+			s = std::max(s, std::fabs(a[k] - b[k]));
+		return s;
+	}
+};
+
+// Reduction kernels for a runtime dimension d (AVX2, SSE2 or scalar)
+template<>
+struct metricKernels<0> {
+#if defined(__AVX2__)
+	static double hsum(__m256d v){
+		__m128d lo = _mm256_castpd256_pd128(v);
+		__m128d hi = _mm256_extractf128_pd(v, 1);
+		lo = _mm_add_pd(lo, hi);
+		return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+	}
+
+	static double dot(const double* a, const double* b, unsigned d){
+		__m256d acc = _mm256_setzero_pd();
+		unsigned k = 0;
+		for(; k + 4 <= d; k += 4)
+			acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k)));
+		double s = hsum(acc);
+		for(; k < d; k++)
+			s += a[k] * b[k];
+		return s;
+	}
+
+	static double sqDist(const double* a, const double* b, unsigned d){
+		__m256d acc = _mm256_setzero_pd();
+		unsigned k = 0;
+		for(; k + 4 <= d; k += 4){
+			__m256d diff = _mm256_sub_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k));
+			acc = _mm256_add_pd(acc, _mm256_mul_pd(diff, diff));
+		}
+		double s = hsum(acc);
+		for(; k < d; k++)
+			s += (a[k] - b[k]) * (a[k] - b[k]);
+		return s;
+	}
+
+	static double absDist(const double* a, const double* b, unsigned d){
+		const __m256d sign = _mm256_set1_pd(-0.0);
+		__m256d acc = _mm256_setzero_pd();
+		unsigned k = 0;
+		for(; k + 4 <= d; k += 4)
+			acc = _mm256_add_pd(acc, _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k))));
+		double s = hsum(acc);
+		for(; k < d; k++)
+			s += std::fabs(a[k] - b[k]);
+		return s;
+	}
+
+	static double maxDist(const double* a, const double* b, unsigned d){
+		const __m256d sign = _mm256_set1_pd(-0.0);
+		__m256d acc = _mm256_setzero_pd();
+		unsigned k = 0;
+		for(; k + 4 <= d; k += 4)
+			acc = _mm256_max_pd(acc, _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k))));
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, acc);
+		double s = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+		for(; k < d; k++)
+			s = std::max(s, std::fabs(a[k] - b[k]));
+		return s;
+	}
+#elif defined(__SSE2__)
+	static double hsum(__m128d v){
+		return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+	}
+
+	static double dot(const double* a, const double* b, unsigned d){
+		__m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+		unsigned k = 0;
+		for(; k + 4 <= d; k += 4){
+			acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + k), _mm_loadu_pd(b + k)));
+			acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + k + 2), _mm_loadu_pd(b + k + 2)));
+		}
+		double s = hsum(_mm_add_pd(acc0, acc1));
+		for(; k < d; k++)
+			s += a[k] * b[k];
+		return s;
+	}
+
+	static double sqDist(const double* a, const double* b, unsigned d){
+		__m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+		unsigned k = 0;
+		for(; k + 4 <= d; k += 4){
+			__m128d diff0 = _mm_sub_pd(_mm_loadu_pd(a + k), _mm_loadu_pd(b + k));
+			__m128d diff1 = _mm_sub_pd(_mm_loadu_pd(a + k + 2), _mm_loadu_pd(b + k + 2));
+			acc0 = _mm_add_pd(acc0, _mm_mul_pd(diff0, diff0));
+			acc1 = _mm_add_pd(acc1, _mm_mul_pd(diff1, diff1));
+		}
+		double s = hsum(_mm_add_pd(acc0, acc1));
+		for(; k < d; k++)
+			s += (a[k] - b[k]) * (a[k] - b[k]);
+		return s;
+	}
+
+	static double absDist(const double* a, const double* b, unsigned d){
+		const __m128d sign = _mm_set1_pd(-0.0);
+		__m128d acc = _mm_setzero_pd();
+		unsigned k = 0;
+		for(; k + 2 <= d; k += 2)
+			acc = _mm_add_pd(acc, _mm_andnot_pd(sign, _mm_sub_pd(_mm_loadu_pd(a + k), _mm_loadu_pd(b + k))));
+		double s = hsum(acc);
+		for(; k < d; k++)
+			s += std::fabs(a[k] - b[k]);
+		return s;
+	}
+
+	static double maxDist(const double* a, const double* b, unsigned d){
+		const __m128d sign = _mm_set1_pd(-0.0);
+		__m128d acc = _mm_setzero_pd();
+		unsigned k = 0;
+		for(; k + 2 <= d; k += 2)
+			acc = _mm_max_pd(acc, _mm_andnot_pd(sign, _mm_sub_pd(_mm_loadu_pd(a + k), _mm_loadu_pd(b + k))));
+		double s = std::max(_mm_cvtsd_f64(acc), _mm_cvtsd_f64(_mm_unpackhi_pd(acc, acc)));
+		for(; k < d; k++)
+			s = std::max(s, std::fabs(a[k] - b[k]));
+		return s;
+	}
+#else
+	static double dot(const double* a, const double* b, unsigned d){
+		double s0 = 0, s1 = 0;
+		unsigned k = 0;
+		for(; k + 2 <= d; k += 2){
+			s0 += a[k] * b[k];
+			s1 += a[k+1] * b[k+1];
+		}
+		for(; k < d; k++)
+			s0 += a[k] * b[k];
+		return s0 + s1;
+	}
+
+	static double sqDist(const double* a, const double* b, unsigned d){
+		double s = 0;
+		for(unsigned k = 0; k < d; k++)
+			s += (a[k] - b[k]) * (a[k] - b[k]);
+		return s;
+	}
+
+	static double absDist(const double* a, const double* b, unsigned d){
+		double s = 0;
+		for(unsigned k = 0; k < d; k++)
+			s += std::fabs(a[k] - b[k]);
+		return s;
+	}
+
+	static double maxDist(const double* a, const double* b, unsigned d){
+		double s = 0;
+		for(unsigned k = 0; k < d; k++)
+			s = std::max(s, std::fabs(a[k] - b[k]));
+		return s;
+	}
+#endif
+};
+
+
+//**													**//
+//** 				Metric Policies 					**//
+//**													**//
+//
+//	eval<D>(a, b, d)	-> distance between two points of dimension d
+//	gram				-> distance can be formed from x.y, ||x||^2 and ||y||^2
+//	fromGram(...)		-> distance from the dot product and squared norms
+//	euclideanBound(...)	-> euclidean radius containing the metric ball of radius eps
+//
+
+struct euclideanMetric {
+	static constexpr bool gram = true;
+
+	template<unsigned D>
+	static double eval(const double* a, const double* b, unsigned d){
+		return std::sqrt(metricKernels<D>::sqDist(a, b, d));
+	}
+
+	static double fromGram(double dot, double aa, double bb){
+		double sq = aa + bb - 2 * dot;
+		return sq > 0 ? std::sqrt(sq) : 0;
+	}
+
+	static double euclideanBound(double eps, unsigned){ return eps; }
+};
+
+struct sqEuclideanMetric {
+	static constexpr bool gram = true;
+
+	template<unsigned D>
+	static double eval(const double* a, const double* b, unsigned d){
+		return metricKernels<D>::sqDist(a, b, d);
+	}
+
+	static double fromGram(double dot, double aa, double bb){
+		double sq = aa + bb - 2 * dot;
+		return sq > 0 ? sq : 0;
+	}
+
+	static double euclideanBound(double eps, unsigned){ return std::sqrt(eps); }
+};
+
+struct manhattanMetric {
+	static constexpr bool gram = false;
+
+	template<unsigned D>
+	static double eval(const double* a, const double* b, unsigned d){
+		return metricKernels<D>::absDist(a, b, d);
+	}
+
+	static double fromGram(double, double, double){ return 0; }
+
+	static double euclideanBound(double eps, unsigned){ return eps; }
+};
+
+struct chebyshevMetric {
+	static constexpr bool gram = false;
+
+	template<unsigned D>
+	static double eval(const double* a, const double* b, unsigned d){
+		return metricKernels<D>::maxDist(a, b, d);
+	}
+
+	static double fromGram(double, double, double){ return 0; }
+
+	static double euclideanBound(double eps, unsigned d){ return eps * std::sqrt((double)d); }
+};
+
+struct cosineMetric {
+	static constexpr bool gram = true;
+
+	template<unsigned D>
+	static double eval(const double* a, const double* b, unsigned d){
+		return fromGram(metricKernels<D>::dot(a, b, d), metricKernels<D>::dot(a, a, d), metricKernels<D>::dot(b, b, d));
+	}
+
+	//Zero vectors are at distance 0 from each other and 1 from everything else
+	static double fromGram(double dot, double aa, double bb){
+		if(aa == 0 || bb == 0)
+			return aa == bb ? 0 : 1;
+		double dist = 1 - dot / std::sqrt(aa * bb);
+		return dist > 0 ? dist : 0;
+	}
+
+	//Not bounded by a euclidean ball; range queries have to visit every point
+	static double euclideanBound(double, unsigned){ return std::numeric_limits<double>::infinity(); }
+};
+
+
+// Distance between two vectors for a metric / dimension tag pair
+//		The general kernels (dimTag<0>) compare the leading min(|a|, |b|) coordinates
+template<class Metric, class Dim>
+inline double metricDistance(const std::vector<double>& a, const std::vector<double>& b){
+	if(a.empty() || b.empty())
+		return 0;
+	return Metric::template eval<Dim::value>(a.data(), b.data(), std::min(a.size(), b.size()));
+}
+
+// Check a metric name against the supported metrics
+inline bool validMetric(const std::string& metric){
+	return metric == "euclidean" || metric == "sqeuclidean" || metric == "manhattan" || metric == "chebyshev" || metric == "cosine";
+}
+
+// Select the fixed-dimension instantiation (or the general kernels)
+template<class Metric, typename F>
+auto dispatchDimension(unsigned dim, F&& f){
+	switch(dim){
+		case 2: return f(Metric(), dimTag<2>());
+		case 3: return f(Metric(), dimTag<3>());
+		case 8: return f(Metric(), dimTag<8>());
+		case 16: return f(Metric(), dimTag<16>());
+		default: return f(Metric(), dimTag<0>());
+	}
+}
+
+// Resolve a metric name and dimension once, then run f(metric, dimTag)
+//		f is a generic lambda; unknown metric names fall back to euclidean
+template<typename F>
+auto dispatchMetric(const std::string& metric, unsigned dim, F&& f){
+	if(metric == "sqeuclidean")
+		return dispatchDimension<sqEuclideanMetric>(dim, f);
+	else if(metric == "manhattan")
+		return dispatchDimension<manhattanMetric>(dim, f);
+	else if(metric == "chebyshev")
+		return dispatchDimension<chebyshevMetric>(dim, f);
+	else if(metric == "cosine")
+		return dispatchDimension<cosineMetric>(dim, f);
+
+	return dispatchDimension<euclideanMetric>(dim, f);
+}
+
+// Distance between two vectors, metric resolved per call (for one-off distances outside hot loops)
+inline double metricDistance(const std::string& metric, const std::vector<double>& a, const std::vector<double>& b){
+	return dispatchMetric(metric, a.size() == b.size() ? a.size() : 0, [&](auto m, auto d){
+		return metricDistance<decltype(m), decltype(d)>(a, b);
+	});
+}
+
+// Distances from a point to each point of a cloud (metric resolved once per call)
+//		The fixed-dimension kernels are only used when every row has the point's dimension
+inline std::vector<double> metricDistances(const std::string& metric, const std::vector<double>& point, const std::vector<std::vector<double>>& cloud){
+	unsigned dim = point.size();
+	for(auto &p : cloud)
+		if(p.size() != dim){
+			dim = 0;
+			break;
+		}
+	
+	return dispatchMetric(metric, dim, [&](auto m, auto d){
+		std::vector<double> ret;
+		ret.reserve(cloud.size());
+		for(auto &p : cloud)
+			ret.push_back(metricDistance<decltype(m), decltype(d)>(point, p));
+		return ret;
+	});
+}
+
+#endif
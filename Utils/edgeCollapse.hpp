@@ -0,0 +1,110 @@
+#pragma once
+
+#ifndef EDGECOLLAPSE_HPP_INCL
+#define EDGECOLLAPSE_HPP_INCL
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+// Header only filtration preserving edge collapse of a flag filtration (see Boissonnat-Pritam-20,
+//		Glisse-Pritam-22). An edge uv is dominated by a vertex w if every common neighbor of u
+//		and v is a neighbor of w; removing it leaves a flag complex with the same homotopy type.
+//
+//		Edges are visited from the last to the first. While an edge is dominated in the graph
+//		of the earlier edges and the already visited edges (at their new values), its
+//		filtration value moves to the next value an edge at u or v enters; an edge dominated
+//		for good is removed. Every step is an inclusion that is a homotopy equivalence, so the
+//		persistence of the flag filtration is unchanged. Passes repeat while edges are removed.
+
+struct filteredEdge {
+	unsigned u, v;
+	double weight;
+};
+
+// Collapse the flag filtration of the edges over n vertices; returns the kept edges with
+//		their (possibly later) filtration values, sorted by value
+inline std::vector<filteredEdge> collapseEdges(unsigned n, std::vector<filteredEdge> edges){
+	const double never = std::numeric_limits<double>::infinity();
+	std::vector<std::unordered_map<unsigned, double>> values(n);
+	std::vector<unsigned> common;
+
+	auto byValue = [](const filteredEdge& a, const filteredEdge& b){
+		if(a.weight != b.weight) return a.weight < b.weight;
+		return a.u != b.u ? a.u < b.u : a.v < b.v;
+	};
+
+	//Edge ab is in the graph at value t
+	auto present = [&](unsigned a, unsigned b, double t){
+		auto it = values[a].find(b);
+		return it != values[a].end() && it->second <= t;
+	};
+
+	//Some common neighbor of u and v at value t is adjacent to all the others
+	auto dominated = [&](unsigned u, unsigned v, double t){
+		common.clear();
+		for(auto& x : values[u])
+			if(x.first != v && x.second <= t && present(v, x.first, t))
+				common.push_back(x.first);
+
+		for(auto w : common){
+			bool dominates = true;
+			for(auto x : common){
+				if(x != w && !present(w, x, t)){
+					dominates = false;
+					break;
+				}
+			}
+			if(dominates)
+				return true;
+		}
+		return false;
+	};
+
+	size_t before;
+	do {
+		before = edges.size();
+		std::sort(edges.begin(), edges.end(), byValue);
+
+		for(auto& row : values)
+			row.clear();
+		for(auto& e : edges){
+			values[e.u][e.v] = e.weight;
+			values[e.v][e.u] = e.weight;
+		}
+
+		std::vector<filteredEdge> kept;
+		for(size_t i = edges.size(); i-- > 0;){
+			unsigned u = edges[i].u, v = edges[i].v;
+			if(values[u].size() > values[v].size())
+				std::swap(u, v);
+
+			//Only visited edges (at u or v) enter after the original value
+			double t = edges[i].weight;
+			while(t != never && dominated(u, v, t)){
+				double next = never;
+				for(unsigned a : {u, v})
+					for(auto& x : values[a])
+						if(x.second > t)
+							next = std::min(next, x.second);
+				t = next;
+			}
+
+			if(t == never){
+				values[u].erase(v);
+				values[v].erase(u);
+			} else {
+				values[u][v] = t;
+				values[v][u] = t;
+				kept.push_back(filteredEdge{edges[i].u, edges[i].v, t});
+			}
+		}
+		edges.swap(kept);
+	} while(edges.size() < before);
+
+	std::sort(edges.begin(), edges.end(), byValue);
+	return edges;
+}
+
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+
+#ifndef FILTRATIONVALUE_HPP_INCL
+#define FILTRATIONVALUE_HPP_INCL
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// Storage type of the filtration value held by each simplex / graph edge
+//		Single precision with the LHF_FLOAT_FILTRATION build option (halves the per-edge weight)
+#ifdef LHF_FLOAT_FILTRATION
+typedef float filtrationValue;
+#else
+typedef double filtrationValue;
+#endif
+
+// Round a computed distance to the precision it will be stored at, so the
+//		filtration weights match the values read back from the complex
+inline double roundFiltration(double value, bool single = false){
+	return single ? (double)(float)value : (double)(filtrationValue)value;
+}
+
+// Compare two filtration values to within a few units of the storage precision,
+//		or the relative tolerance given if that is larger (computed values)
+inline bool filtrationEqual(double a, double b, double tolerance = 0){
+	double scale = std::max(1.0, std::max(std::abs(a), std::abs(b)));
+	return std::abs(a - b) <= std::max(tolerance, 4 * (double)std::numeric_limits<filtrationValue>::epsilon()) * scale;
+}
+
+#endif
@@ -0,0 +1,79 @@
+#pragma once
+
+#ifndef PRIMEFIELD_HPP_INCL
+#define PRIMEFIELD_HPP_INCL
+
+#include <vector>
+
+// Header only prime field Z/p for matrix reduction over other coefficients than Z2
+//		Z2 (p = 2) keeps the coefficient free paths (bitMatrix, pivotColumn); for odd p
+//		columns are sorted (row, coefficient) entries and each column addition is a merge
+//		scaled by a precomputed modular inverse. Coefficients are stored in 16 bits, so p
+//		must be a prime below 2^16.
+
+struct fieldEntry {
+	unsigned row;
+	unsigned short coeff;
+};
+
+class primeField {
+  private:
+	unsigned p = 2;
+	std::vector<unsigned short> inverses;
+
+  public:
+	static const unsigned maxCharacteristic = 65521;		//Largest prime below 2^16
+
+	static bool isPrime(unsigned n){
+		if(n < 2)
+			return false;
+		for(unsigned d = 2; d * d <= n; d++)
+			if(n % d == 0)
+				return false;
+		return true;
+	};
+
+	// Z/p, p prime and at most maxCharacteristic
+	primeField(unsigned p = 2) : p(p), inverses(p, 0){
+		//inv(a) = -(p / a) * inv(p mod a)
+		if(p > 1)
+			inverses[1] = 1;
+		for(unsigned a = 2; a < p; a++)
+			inverses[a] = (unsigned short)(p - ((unsigned long long)(p / a) * inverses[p % a]) % p);
+	};
+
+	unsigned characteristic() const { return p; };
+
+	//Operands are reduced (< p < 2^16), so sums and products fit in 32 bits
+	unsigned short add(unsigned a, unsigned b) const { return a + b >= p ? a + b - p : a + b; };
+	unsigned short neg(unsigned a) const { return a == 0 ? 0 : p - a; };
+	unsigned short mul(unsigned a, unsigned b) const { return (a * b) % p; };
+	unsigned short inverse(unsigned a) const { return inverses[a]; };
+
+	// Image of an integer (e.g. a boundary sign) in Z/p
+	unsigned short fromInt(long long a) const { return ((a % (long long)p) + p) % p; };
+
+	// dst += factor * src; both sorted by row, zero entries are dropped
+	void addScaled(std::vector<fieldEntry>& dst, unsigned factor, const std::vector<fieldEntry>& src, std::vector<fieldEntry>& scratch) const {
+		scratch.clear();
+		auto a = dst.begin();
+		auto b = src.begin();
+		while(a != dst.end() || b != src.end()){
+			if(b == src.end() || (a != dst.end() && a->row < b->row)){
+				scratch.push_back(*a++);
+			} else if(a == dst.end() || b->row < a->row){
+				scratch.push_back(fieldEntry{b->row, mul(factor, b->coeff)});
+				b++;
+			} else {
+				unsigned short c = add(a->coeff, mul(factor, b->coeff));
+				if(c != 0)
+					scratch.push_back(fieldEntry{a->row, c});
+				a++;
+				b++;
+			}
+		}
+		dst.swap(scratch);
+	};
+};
+
+#endif
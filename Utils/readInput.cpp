@@ -14,7 +14,10 @@
 #include <regex>
 #include <fstream>
 #include <cmath>
+#include <algorithm>
+#include <utility>
 #include "readInput.hpp"
+#include "filtrationValue.hpp"
 
 
 // readInput constructor, currently no needed information for the class constructor
@@ -146,6 +149,107 @@ std::vector<std::vector<double>> readInput::readMAT(std::string filename){
 }
 
 
+// readDistMatrix -> read a precomputed distance matrix from a csv file
+//		-filename - complete filename and relative path (if needed) for reading
+//
+// Formatted as one row per point; upper triangular, lower triangular (rows may
+//		be ragged) or full symmetric matrices are accepted. The larger of d(i,j)
+//		and d(j,i) is kept, so the zeroed triangle is ignored.
+//
+condensedDistMatrix readInput::readDistMatrix(std::string filename){
+	std::ifstream file(filename);
+	
+	if(!file){
+		std::cout << "Failed to open file: " << filename << std::endl;
+		return condensedDistMatrix();
+	}
+	
+	// First pass counts the rows (points) to size the condensed matrix
+	unsigned n = 0;
+	std::string line;
+	while(getline(file, line)){
+		if(line.find_first_not_of(" \t\r,") != std::string::npos)
+			n++;
+	}
+	
+	condensedDistMatrix result(n);
+	file.clear();
+	file.seekg(0);
+	
+	unsigned i = 0;
+	while(i < n && getline(file, line)){
+		std::vector<double> row;
+		if(line.find_first_not_of(" \t\r,") == std::string::npos)
+			continue;
+		
+		// Single value rows (first row of a lower triangle) are too short for parseDoubleVector
+		if(!parseDoubleVector(line, row))
+			row.push_back(std::stod(line));
+		
+		for(unsigned j = 0; j < row.size() && j < n; j++){
+			if(j != i && row[j] > result(i, j))
+				result.set(i, j, row[j]);
+		}
+		i++;
+	}
+	
+	return result;
+}
+
+
+// readEdgeList -> read a weighted edge list from a csv file
+//		-filename - complete filename and relative path (if needed) for reading
+//
+// Formatted as:	i,j,weight	(edge between points i and j)
+//					i,weight	(point i, declares isolated points)
+//
+// Lines with more fields (higher simplices) are skipped; they are rebuilt by the
+//		rips expansion. Repeated edges keep the smallest weight.
+//
+sparseNeighborGraph readInput::readEdgeList(std::string filename){
+	std::vector<std::vector<std::pair<unsigned, double>>> adjacency;
+	std::ifstream file(filename);
+	
+	if(!file){
+		std::cout << "Failed to open file: " << filename << std::endl;
+		return sparseNeighborGraph();
+	}
+	
+	std::string line;
+	while(getline(file, line)){
+		std::vector<double> row;
+		if(line.find_first_not_of(" \t\r,") == std::string::npos)
+			continue;
+		
+		// Single value rows (first row of a lower triangle) are too short for parseDoubleVector
+		if(!parseDoubleVector(line, row))
+			row.push_back(std::stod(line));
+		
+		if(row.size() == 2 || row.size() == 3){
+			unsigned a = row[0];
+			unsigned b = row.size() == 3 ? (unsigned)row[1] : a;
+			
+			if(std::max(a, b) >= adjacency.size())
+				adjacency.resize(std::max(a, b) + 1);
+			
+			if(a != b){
+				double weight = roundFiltration(row[2]);
+				adjacency[a].push_back(std::make_pair(b, weight));
+				adjacency[b].push_back(std::make_pair(a, weight));
+			}
+		}
+	}
+	
+	// Sorted by (neighbor, weight), keep the first (smallest) weight of each neighbor
+	for(auto &neighbors : adjacency){
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end(), [](const std::pair<unsigned, double> &x, const std::pair<unsigned, double> &y){ return x.first == y.first; }), neighbors.end());
+	}
+	
+	return sparseNeighborGraph(adjacency);
+}
+
+
 bool readInput::streamInit(std::string filename){
 	pFile = fopen(filename.c_str(), "r");
 	
@@ -1,6 +1,10 @@
 #pragma once
 
 // Header file for readInput class - see readInput.cpp for descriptions
+#include <string>
+#include <vector>
+#include "condensedDistMatrix.hpp"
+#include "sparseNeighborGraph.hpp"
 
 class readInput {
   private:
@@ -12,6 +16,8 @@ class readInput {
     readInput();
     std::vector<std::vector<double>> readCSV(std::string filename);
     std::vector<std::vector<double>> readMAT(std::string filename);
+    condensedDistMatrix readDistMatrix(std::string filename);
+    sparseNeighborGraph readEdgeList(std::string filename);
     bool streamInit(std::string filename);
     bool streamRead(std::vector<double>&);
 };
@@ -0,0 +1,125 @@
+#pragma once
+
+#ifndef SMALLSIMPLEX_HPP_INCL
+#define SMALLSIMPLEX_HPP_INCL
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <initializer_list>
+#include <utility>
+#include <cstddef>
+
+// Header only, fixed capacity simplex (sorted vertex indices stored inline)
+//		Mirrors the std::set<unsigned> interface used across the complexes and
+//		pipes, so copies, faces, cofaces, unions and intersections never touch
+//		the heap. Capacity is maxDimension + 2 vertices (the top dimension plus
+//		its cofaces); raise LHF_MAX_SIMPLEX_VERTICES for higher dimensions.
+
+#ifndef LHF_MAX_SIMPLEX_VERTICES
+#define LHF_MAX_SIMPLEX_VERTICES 8
+#endif
+
+class smallSimplex {
+  public:
+	typedef unsigned value_type;
+	typedef unsigned key_type;
+	typedef const unsigned& reference;
+	typedef const unsigned& const_reference;
+	typedef const unsigned* iterator;
+	typedef const unsigned* const_iterator;
+	typedef std::reverse_iterator<const_iterator> reverse_iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+	typedef size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	static const unsigned capacity = LHF_MAX_SIMPLEX_VERTICES;
+
+  private:
+	unsigned length = 0;
+	unsigned vertices[LHF_MAX_SIMPLEX_VERTICES];
+
+  public:
+	smallSimplex(){};
+	smallSimplex(std::initializer_list<unsigned> list){ insert(list.begin(), list.end()); };
+	template<typename It> smallSimplex(It first, It last){ insert(first, last); };
+
+	const_iterator begin() const { return vertices; };
+	const_iterator end() const { return vertices + length; };
+	const_iterator cbegin() const { return begin(); };
+	const_iterator cend() const { return end(); };
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); };
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); };
+
+	size_type size() const { return length; };
+	size_type max_size() const { return capacity; };
+	bool empty() const { return length == 0; };
+	void clear(){ length = 0; };
+
+	// Insert a vertex in sorted position (no-op if present)
+	std::pair<iterator, bool> insert(unsigned v){
+		unsigned* pos = std::lower_bound(vertices, vertices + length, v);
+		if(pos != vertices + length && *pos == v)
+			return std::make_pair((iterator)pos, false);
+		if(length == capacity)
+			throw std::length_error("smallSimplex: more than LHF_MAX_SIMPLEX_VERTICES vertices");
+
+		std::copy_backward(pos, vertices + length, vertices + length + 1);
+		*pos = v;
+		length++;
+		return std::make_pair((iterator)pos, true);
+	};
+	iterator insert(const_iterator, unsigned v){ return insert(v).first; };
+	template<typename It> void insert(It first, It last){
+		for(; first != last; ++first)
+			insert((unsigned)*first);
+	};
+
+	size_type erase(unsigned v){
+		auto pos = find(v);
+		if(pos == end())
+			return 0;
+		erase(pos);
+		return 1;
+	};
+	iterator erase(const_iterator pos){
+		unsigned* p = vertices + (pos - vertices);
+		std::copy(p + 1, vertices + length, p);
+		length--;
+		return p;
+	};
+
+	const_iterator find(unsigned v) const {
+		auto pos = std::lower_bound(begin(), end(), v);
+		return (pos != end() && *pos == v) ? pos : end();
+	};
+	size_type count(unsigned v) const { return find(v) != end(); };
+
+	// True if every vertex of the other simplex is a vertex of this one
+	bool includes(const smallSimplex& other) const { return std::includes(begin(), end(), other.begin(), other.end()); };
+
+	// Face opposite vertex k (the k-th smallest vertex removed)
+	smallSimplex face(unsigned k) const {
+		smallSimplex ret;
+		std::copy(vertices, vertices + k, ret.vertices);
+		std::copy(vertices + k + 1, vertices + length, ret.vertices + k);
+		ret.length = length - 1;
+		return ret;
+	};
+
+	// Coface with vertex v added
+	smallSimplex coface(unsigned v) const {
+		smallSimplex ret = *this;
+		ret.insert(v);
+		return ret;
+	};
+
+	friend bool operator==(const smallSimplex& a, const smallSimplex& b){ return a.length == b.length && std::equal(a.begin(), a.end(), b.begin()); };
+	friend bool operator!=(const smallSimplex& a, const smallSimplex& b){ return !(a == b); };
+	friend bool operator<(const smallSimplex& a, const smallSimplex& b){ return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()); };
+	friend bool operator>(const smallSimplex& a, const smallSimplex& b){ return b < a; };
+	friend bool operator<=(const smallSimplex& a, const smallSimplex& b){ return !(b < a); };
+	friend bool operator>=(const smallSimplex& a, const smallSimplex& b){ return !(a < b); };
+};
+
+#endif
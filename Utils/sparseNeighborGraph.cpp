@@ -0,0 +1,65 @@
+/*
+ * sparseNeighborGraph hpp + cpp define a compressed sparse row (CSR)
+ * adjacency of the epsilon-neighborhood graph of a point cloud. Only
+ * pairs within epsilon are stored (in both directions, sorted by
+ * neighbor), so memory grows with the number of edges instead of n^2.
+ *
+ */
+
+#include <algorithm>
+#include "sparseNeighborGraph.hpp"
+
+// sparseNeighborGraph constructor, empty graph
+sparseNeighborGraph::sparseNeighborGraph(){
+
+}
+
+// sparseNeighborGraph constructor, compress per-point (neighbor, distance) lists
+//		Each list is sorted in place; the lists should be symmetric
+sparseNeighborGraph::sparseNeighborGraph(std::vector<std::vector<std::pair<unsigned, double>>>& adjacency){
+	n = adjacency.size();
+	rowStart.assign(n + 1, 0);
+
+	for(unsigned i = 0; i < n; i++)
+		rowStart[i+1] = rowStart[i] + adjacency[i].size();
+
+	neighbors.reserve(rowStart[n]);
+	weights.reserve(rowStart[n]);
+
+	for(auto &row : adjacency){
+		std::sort(row.begin(), row.end());
+		for(auto &edge : row){
+			neighbors.push_back(edge.first);
+			weights.push_back(edge.second);
+		}
+	}
+}
+
+// Distance between points i and j, binary search of row i
+double sparseNeighborGraph::operator()(unsigned i, unsigned j) const{
+	if(i == j)
+		return 0;
+
+	auto first = neighborsBegin(i);
+	auto last = neighborsEnd(i);
+	auto it = std::lower_bound(first, last, j);
+
+	if(it == last || *it != j)
+		return std::numeric_limits<double>::infinity();
+
+	return weights[rowStart[i] + (it - first)];
+}
+
+// Memory used by the stored adjacency (bytes)
+double sparseNeighborGraph::getSize() const{
+	return rowStart.size() * sizeof(size_t) + neighbors.size() * sizeof(unsigned) + weights.size() * sizeof(filtrationValue);
+}
+
+// Release the stored adjacency
+void sparseNeighborGraph::clear(){
+	n = 0;
+	std::vector<size_t>().swap(rowStart);
+	std::vector<unsigned>().swap(neighbors);
+	std::vector<filtrationValue>().swap(weights);
+	return;
+}
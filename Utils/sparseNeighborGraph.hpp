@@ -0,0 +1,40 @@
+#pragma once
+
+#ifndef SPARSENEIGHBORGRAPH_HPP_INCL
+#define SPARSENEIGHBORGRAPH_HPP_INCL
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <cstddef>
+#include "filtrationValue.hpp"
+
+// Header file for sparseNeighborGraph class - see sparseNeighborGraph.cpp for descriptions
+
+class sparseNeighborGraph {
+  private:
+	unsigned n = 0;
+	std::vector<size_t> rowStart;
+	std::vector<unsigned> neighbors;
+	std::vector<filtrationValue> weights;
+
+  public:
+	sparseNeighborGraph();
+	sparseNeighborGraph(std::vector<std::vector<std::pair<unsigned, double>>>&);
+
+	//Symmetric lookup, the diagonal is 0 and absent edges are infinitely far apart
+	double operator()(unsigned, unsigned) const;
+
+	unsigned size() const { return n; };
+	bool empty() const { return n == 0; };
+	size_t edgeCount() const { return neighbors.size() / 2; };
+	unsigned degree(unsigned i) const { return rowStart[i+1] - rowStart[i]; };
+	const unsigned* neighborsBegin(unsigned i) const { return neighbors.data() + rowStart[i]; };
+	const unsigned* neighborsEnd(unsigned i) const { return neighbors.data() + rowStart[i+1]; };
+	const filtrationValue* weightsBegin(unsigned i) const { return weights.data() + rowStart[i]; };
+	double getSize() const;
+
+	void clear();
+};
+
+#endif
@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef UNIONFIND_HPP_INCL
+#define UNIONFIND_HPP_INCL
+
+#include <vector>
+#include <numeric>
+#include <utility>
+
+// Header only disjoint sets (union by rank, path compression) and H0 persistence
+//		Each component carries the birth of its oldest vertex; joining two components
+//		kills the younger one (elder rule). zeroPersistence runs this over a weight
+//		sorted edge list, which gives the H0 intervals and the pivots (minimum
+//		spanning forest edges) of the edge boundary matrix in near-linear time.
+
+class unionFind {
+  private:
+	std::vector<unsigned> parent;
+	std::vector<unsigned char> rank;
+	std::vector<double> births;
+	unsigned components = 0;
+
+  public:
+	unionFind(){};
+	unionFind(unsigned n){ reset(std::vector<double>(n, 0)); };
+	unionFind(const std::vector<double>& vertexBirths){ reset(vertexBirths); };
+
+	// One singleton component per vertex, born at vertexBirths[i]
+	void reset(const std::vector<double>& vertexBirths){
+		births = vertexBirths;
+		parent.resize(births.size());
+		std::iota(parent.begin(), parent.end(), 0);
+		rank.assign(births.size(), 0);
+		components = births.size();
+	};
+
+	unsigned find(unsigned x){
+		unsigned root = x;
+		while(parent[root] != root)
+			root = parent[root];
+		while(parent[x] != root){
+			unsigned next = parent[x];
+			parent[x] = root;
+			x = next;
+		}
+		return root;
+	};
+
+	// Join the components of a and b; returns false if they are already joined,
+	//		otherwise sets died to the birth of the younger component
+	bool join(unsigned a, unsigned b, double& died){
+		a = find(a);
+		b = find(b);
+		if(a == b)
+			return false;
+
+		//Elder rule: the component born later (ties: larger root) dies
+		bool aElder = births[a] < births[b] || (births[a] == births[b] && a < b);
+		died = aElder ? births[b] : births[a];
+		double born = aElder ? births[a] : births[b];
+
+		if(rank[a] < rank[b])
+			std::swap(a, b);
+		parent[b] = a;
+		if(rank[a] == rank[b])
+			rank[a]++;
+		births[a] = born;
+		components--;
+		return true;
+	};
+	bool join(unsigned a, unsigned b){ double died; return join(a, b, died); };
+
+	unsigned size() const { return parent.size(); };
+	unsigned count() const { return components; };
+	double birth(unsigned x){ return births[find(x)]; };
+};
+
+
+// H0 interval closed by a merging edge
+struct zeroPair {
+	unsigned edge;			//Position of the edge in the edge list (boundary matrix pivot)
+	unsigned u, v;			//Edge vertices
+	double birth;			//Birth of the younger component
+	double death;			//Edge weight
+};
+
+// H0 intervals of a filtration; vertices and edges are (simplex, weight) lists, the edges
+//		sorted by weight (getAllEdges order). Vertices absent from the vertex list are born at 0.
+//		Stops once every vertex is in one component.
+template<typename Chain>
+std::vector<zeroPair> zeroPersistence(const Chain& vertices, const Chain& edges){
+	std::vector<zeroPair> ret;
+
+	unsigned n = 0;
+	for(auto& s : vertices)
+		if(!s.first.empty()) n = std::max(n, *s.first.rbegin() + 1);
+	for(auto& s : edges)
+		if(!s.first.empty()) n = std::max(n, *s.first.rbegin() + 1);
+
+	std::vector<double> births(n, 0);
+	for(auto& s : vertices)
+		if(!s.first.empty()) births[*s.first.begin()] = s.second;
+
+	unionFind components(births);
+	for(unsigned i = 0; i < edges.size() && components.count() > 1; i++){
+		if(edges[i].first.size() != 2)
+			continue;
+		unsigned u = *edges[i].first.begin(), v = *edges[i].first.rbegin();
+		double died;
+		if(components.join(u, v, died))
+			ret.push_back(zeroPair{i, u, v, died, edges[i].second});
+	}
+
+	return ret;
+}
+
+#endif
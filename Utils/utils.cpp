@@ -6,6 +6,7 @@
 #include <iostream>
 #include <fstream>
 #include "utils.hpp"
+#include "distanceMetrics.hpp"
 
 // utils constructor, currently no needed information for the class constructor
 utils::utils(){
@@ -142,6 +143,14 @@ void utils::print1DVector(const std::set<unsigned>& a){
 	return;
 }
 
+void utils::print1DVector(const smallSimplex& a){
+	for(auto z : a){
+			std::cout << z << ",";
+	}
+	std::cout << "\n";
+	return;
+}
+
 std::vector<double> utils::feature_distance(std::vector<double>* a, std::vector<double>* b){
 	std::vector<double> ret;
 	
@@ -166,18 +175,11 @@ std::set<unsigned> utils::setXOR(std::set<unsigned>& setA, std::set<unsigned>& s
 }
 
 double utils::vectors_distance(const std::vector<double>& a, const std::vector<double>& b){		
-		std::vector<double> temp;
-		
-		if(b.size() == 0)
-			return 0;
-		
-		std::transform(a.begin(), a.end(), b.begin(), std::back_inserter(temp),[](double e1, double e2) {return pow((e1-e2),2);});
-	
-		
-	
-		return sqrt(std::accumulate(temp.begin(), temp.end(), 0.0));
+		//Euclidean distance through the metric kernels (no temporary vector)
+		return metricDistance<euclideanMetric, dimTag<0>>(a, b);
 }
 
+
 std::vector<unsigned> utils::setIntersect(std::vector<unsigned> v1, std::vector<unsigned> v2, bool isSorted){
 	std::vector<unsigned> ret;
 	
@@ -312,6 +314,30 @@ std::vector<unsigned> utils::symmetricDiff(std::vector<unsigned> v1, std::vector
 	return retTemp;
 }
 
+//Intersection of two simplices (both are always sorted)
+smallSimplex utils::setIntersect(const smallSimplex& v1, const smallSimplex& v2, bool isSorted){
+	smallSimplex ret;
+
+	if(v1 == v2)
+		return v1;
+
+	std::set_intersection(v1.begin(), v1.end(), v2.begin(), v2.end(), std::inserter(ret, ret.end()));
+
+	return ret;
+}
+
+// Find the symmetric difference of two simplices
+std::vector<unsigned> utils::symmetricDiff(const smallSimplex& v1, const smallSimplex& v2, bool isSorted){
+	std::vector<unsigned> ret;
+
+	if(v1 == v2)
+		return ret;
+
+	std::set_symmetric_difference(v1.begin(), v1.end(), v2.begin(), v2.end(), back_inserter(ret));
+
+	return ret;
+}
+
 // Find the symmetric difference of two vectors
 std::vector<unsigned> utils::symmetricDiff(std::set<unsigned> v1, std::set<unsigned> v2, bool isSorted){
 	std::vector<unsigned> ret;
@@ -373,6 +399,36 @@ std::vector<std::set<unsigned>> utils::getSubsets(std::set<unsigned> set, int di
 	return retSubset;
 }
 
+//Subsets of the simplex with dim vertices, built inline
+std::vector<smallSimplex> utils::getSubsets(const smallSimplex& set, int dim){
+	std::vector<smallSimplex> retSubset;
+
+	if(dim < 0 || (unsigned)dim > set.size())
+		return retSubset;
+
+	//Walk the increasing index combinations of length dim
+	std::vector<unsigned> pick(dim);
+	for(int i = 0; i < dim; i++)
+		pick[i] = i;
+
+	const unsigned n = set.size();
+	while(true){
+		smallSimplex sub;
+		for(int i = 0; i < dim; i++)
+			sub.insert(*(set.begin() + pick[i]));
+		retSubset.push_back(sub);
+
+		int i = dim - 1;
+		while(i >= 0 && pick[i] == n - dim + i) i--;
+		if(i < 0) break;
+		pick[i]++;
+		for(int j = i + 1; j < dim; j++)
+			pick[j] = pick[j-1] + 1;
+	}
+
+	return retSubset;
+}
+
 // Find the union of two vectors
 std::vector<unsigned> utils::setUnion(std::vector<unsigned> v1, std::vector<unsigned> v2, bool isSorted){
 	std::vector<unsigned> ret;
@@ -433,7 +489,7 @@ void utils::writeFile(std::string fullMessage){
 }
 
 
-bool utils::sortBySecond(const std::pair<std::set<unsigned>, double> &a, const std::pair<std::set<unsigned>, double> &b){
+bool utils::sortBySecond(const std::pair<smallSimplex, double> &a, const std::pair<smallSimplex, double> &b){
 	return (a.second < b.second);
 }
 
@@ -471,6 +527,17 @@ std::vector<std::set<unsigned>> utils::getSubsets(std::set<unsigned> set){
 	return retSubset;
 }
 
+//Faces (codimension 1 subsets) of the simplex
+std::vector<smallSimplex> utils::getSubsets(const smallSimplex& set){
+	std::vector<smallSimplex> retSubset;
+	retSubset.reserve(set.size());
+
+	for(unsigned k = 0; k < set.size(); k++)
+		retSubset.push_back(set.face(k));
+
+	return retSubset;
+}
+
 //Iteratively build subsets (faces) of the simplex set
 std::vector<std::vector<unsigned>> utils::getSubsets(std::vector<unsigned> set){
 	std::vector<std::vector<unsigned>> subset;
@@ -5,6 +5,7 @@
 
 #include <set>
 #include <vector>
+#include "smallSimplex.hpp"
 
 // Header file for utils class - see utils.cpp for descriptions
 
@@ -32,6 +33,7 @@ class utils {
 	void print2DVector(const std::vector<std::vector<unsigned>>&);
 	void print1DVector(const std::vector<unsigned>&);
 	void print1DVector(const std::set<unsigned>&);
+	void print1DVector(const smallSimplex&);
 	void print1DVector(const std::vector<double>&);
 	std::vector<double> feature_distance(std::vector<double>*, std::vector<double>*);
 	double vectors_distance(const double&, const double&);
@@ -40,9 +42,12 @@ class utils {
 	std::set<unsigned> setXOR(std::set<unsigned>&, std::set<unsigned>&);
 	std::set<unsigned> setIntersect(std::set<unsigned>, std::set<unsigned>, bool isSorted);
 	std::vector<unsigned> setIntersect(std::vector<unsigned>, std::vector<unsigned>, bool);
+	smallSimplex setIntersect(const smallSimplex&, const smallSimplex&, bool);
 	std::vector<std::set<unsigned>> getSubsets(std::set<unsigned>, int);
+	std::vector<smallSimplex> getSubsets(const smallSimplex&, int);
 	std::vector<unsigned> symmetricDiff(std::vector<unsigned>, std::vector<unsigned>, bool);
 	std::vector<unsigned> symmetricDiff(std::set<unsigned>, std::set<unsigned>, bool);
+	std::vector<unsigned> symmetricDiff(const smallSimplex&, const smallSimplex&, bool);
 	std::vector<unsigned> setUnion(std::vector<unsigned>, std::vector<unsigned>, bool);
 	std::pair<std::vector<unsigned>, std::vector<unsigned>> intersect(std::vector<unsigned>, std::vector<unsigned>, bool);
 	
@@ -52,8 +57,9 @@ class utils {
 	void writeError(std::string module, std::string error){writeLog(module,error);return;};
 	void writeFile(std::string fullMessage);
 	
-	static bool sortBySecond(const std::pair<std::set<unsigned>, double> &, const std::pair<std::set<unsigned>, double> &);
+	static bool sortBySecond(const std::pair<smallSimplex, double> &, const std::pair<smallSimplex, double> &);
 	std::vector<std::set<unsigned>> getSubsets(std::set<unsigned> set);
+	std::vector<smallSimplex> getSubsets(const smallSimplex& set);
 	std::vector<std::vector<unsigned>> getSubsets(std::vector<unsigned> set);
 	
 	std::vector<double> nearestNeighbors(std::vector<double>&, std::vector<std::vector<double>>&);
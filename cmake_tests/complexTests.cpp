@@ -1,6 +1,19 @@
 #include <iostream>
 #include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
 #include "simplexBase.hpp"
+#include "condensedDistMatrix.hpp"
+#include "sparseNeighborGraph.hpp"
+#include "filtrationValue.hpp"
+#include "simplexTree.hpp"
+#include "nodeArena.hpp"
+#include "unionFind.hpp"
+#include "bitMatrix.hpp"
+#include "primeField.hpp"
+#include "twistReduction.hpp"
 
 
 
@@ -11,7 +24,7 @@ void t_simp_functions(std::string &log){
 	std::vector<double> testValue = {0.0, 1.0, 2.0};
 	std::vector<std::vector<double>> testValueArray {{0.0, 1.0, 2.0},{2.0, 1.0, 0.0}};
 	std::vector<unsigned> findValue = {0};
-	std::set<unsigned> findValueSet = {0,1};
+	smallSimplex findValueSet = {0,1};
 	
 	//Insert values into uninitialized complex
 	//	RET: void
@@ -52,7 +65,7 @@ void t_simp_functions(std::string &log){
 	if(testComplex->getDimEdges(2, 5.0).size() != 0) { failLog += "simplexBase getDimEdges failed\n"; }
 	
 	//Get all edges from uninitialized complex
-	//	RET: std::vector<std::vector<std::pair<std::set<unsigned>, double>>>
+	//	RET: std::vector<std::vector<std::pair<smallSimplex, double>>>
 	if(testComplex->getAllEdges(5.0).size() != 0) { failLog += "simplexBase getAllEdges failed\n"; }
 	
 	//Get indexed edges from uninitialized complex
@@ -134,7 +147,7 @@ void t_simp_base_functions(std::string &log, std::string type){
 	std::vector<std::vector<double>> emptyValueArray = {};
 											
 	std::vector<unsigned> findValue = {0};
-	std::set<unsigned> findValueSet = {0};
+	smallSimplex findValueSet = {0};
 	
 	testComplex = testComplex->newSimplex(type, config);
 	
@@ -180,7 +193,7 @@ void t_simp_base_functions(std::string &log, std::string type){
 	if(testComplex->getDimEdges(2, 5.0).size() != 0) { failLog += type + " getDimEdges failed\n"; }
 	
 	//Get all edges from uninitialized complex
-	//	RET: std::vector<std::vector<std::pair<std::set<unsigned>, double>>>
+	//	RET: std::vector<std::vector<std::pair<smallSimplex, double>>>
 	if(testComplex->getAllEdges(5.0).size() != 0) { failLog += type + " getAllEdges failed\n"; }
 	
 	//Get indexed edges from uninitialized complex
@@ -223,7 +236,7 @@ void t_simp_empty_functions(std::string &log, std::string type){
 	std::vector<double> testValue = {0.0, 1.0, 2.0};
 	std::vector<std::vector<double>> testValueArray {{0.0, 1.0, 2.0},{2.0, 1.0, 0.0}};
 	std::vector<unsigned> findValue = {0};
-	std::set<unsigned> findValueSet = {0};
+	smallSimplex findValueSet = {0};
 	
 	testComplex = testComplex->newSimplex(type, config);
 	//Don't insert anything into the complex and test our functions
@@ -258,7 +271,7 @@ void t_simp_empty_functions(std::string &log, std::string type){
 	if(testComplex->getDimEdges(2, 5.0).size() != 0) { failLog += type + " getDimEdges failed\n"; }
 	
 	//Get all edges from empty complex
-	//	RET: std::vector<std::vector<std::pair<std::set<unsigned>, double>>>
+	//	RET: std::vector<std::vector<std::pair<smallSimplex, double>>>
 	if(testComplex->getAllEdges(5.0).size() != 0) { failLog += type + " getAllEdges failed\n"; }
 	
 	//Get indexed edges from empty complex
@@ -287,9 +300,393 @@ void t_simp_empty_functions(std::string &log, std::string type){
 	}
 }
 
+// TEST condensedDistMatrix Functions
+void t_condensed_matrix_functions(std::string &log){
+	std::string failLog = "";
+	condensedDistMatrix testMatrix(4);
+	
+	//Fill the matrix with d(i,j) = 10i + j
+	for(unsigned i = 0; i < 4; i++)
+		for(unsigned j = i + 1; j < 4; j++)
+			testMatrix.set(i, j, 10*i + j);
+	
+	//Check size, symmetric lookup and the zero diagonal
+	//	RET: double
+	if(testMatrix.entryCount() != 6) { failLog += "condensedDistMatrix entryCount failed\n"; }
+	if(testMatrix(1,3) != 13 || testMatrix(3,1) != 13) { failLog += "condensedDistMatrix lookup failed\n"; }
+	if(testMatrix(2,2) != 0) { failLog += "condensedDistMatrix diagonal failed\n"; }
+	
+	//Append a point with distances {40, 41, 42, 43}
+	//	RET: void
+	testMatrix.appendPoint({40, 41, 42, 43});
+	if(testMatrix.size() != 5 || testMatrix(4,2) != 42 || testMatrix(0,3) != 3) { failLog += "condensedDistMatrix appendPoint failed\n"; }
+	
+	//Remove point 1; old point 3 becomes point 2
+	//	RET: void
+	testMatrix.removePoint(1);
+	if(testMatrix.size() != 4 || testMatrix(0,2) != 3 || testMatrix(2,3) != 43 || testMatrix(1,2) != 23) { failLog += "condensedDistMatrix removePoint failed\n"; }
+	
+	//Save and map the matrix back from a cache file, writes copy out of the mapping
+	//	RET: bool
+	std::vector<double> weights = {43, 23, 3};
+	std::vector<double> loadedWeights;
+	condensedDistMatrix loaded;
+	if(!testMatrix.save("condensedDistMatrix_test.bin", weights) || !loaded.load("condensedDistMatrix_test.bin", loadedWeights)) { failLog += "condensedDistMatrix save/load failed\n"; }
+	else {
+		if(!loaded.isMapped() || loaded.size() != 4 || loaded(2,3) != 43 || loaded(1,0) != testMatrix(0,1) || loadedWeights != weights) { failLog += "condensedDistMatrix load values failed\n"; }
+		loaded.set(2, 3, 7);
+		if(loaded.isMapped() || loaded(3,2) != 7 || loaded(1,2) != 23) { failLog += "condensedDistMatrix mapped write failed\n"; }
+	}
+	std::remove("condensedDistMatrix_test.bin");
+	if(loaded.load("condensedDistMatrix_test.bin", loadedWeights)) { failLog += "condensedDistMatrix load missing file failed\n"; }
+	
+	//Compact to ranks of the values under epsilon (30), larger values read back as infinity
+	//	RET: valueStorage
+	condensedDistMatrix ranked = testMatrix;
+	if(ranked.compact(condensedDistMatrix::storeRank16, 30) != condensedDistMatrix::storeRank16) { failLog += "condensedDistMatrix compact rank16 failed\n"; }
+	if(ranked(0,1) != testMatrix(0,1) || ranked(2,1) != 23 || !std::isinf(ranked(3,2)) || ranked.getSize() >= testMatrix.getSize()) { failLog += "condensedDistMatrix rank values failed\n"; }
+	ranked.set(0, 1, 5);
+	if(ranked.getStorage() != condensedDistMatrix::storeDouble || ranked(1,0) != 5 || ranked(1,2) != 23) { failLog += "condensedDistMatrix rank write failed\n"; }
+	
+	condensedDistMatrix single = testMatrix;
+	single.compact(condensedDistMatrix::storeFloat, 30);
+	if(single.getStorage() != condensedDistMatrix::storeFloat || single(2,3) != 43) { failLog += "condensedDistMatrix compact float failed\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: condensedDistMatrix Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: condensedDistMatrix Test Functions---------------------------\n";
+	}
+	
+	return;
+}
+
+// TEST sparseNeighborGraph Functions
+void t_sparse_graph_functions(std::string &log){
+	std::string failLog = "";
+	
+	//Path 0 - 1 - 2 plus an isolated point 3, lists given unsorted
+	std::vector<std::vector<std::pair<unsigned, double>>> adjacency = {
+		{{1, 0.5}},
+		{{2, 0.7}, {0, 0.5}},
+		{{1, 0.7}},
+		{}
+	};
+	sparseNeighborGraph testGraph(adjacency);
+	
+	//Check size, degree and sorted neighbors
+	//	RET: unsigned
+	if(testGraph.size() != 4 || testGraph.edgeCount() != 2) { failLog += "sparseNeighborGraph size failed\n"; }
+	if(testGraph.degree(1) != 2 || *testGraph.neighborsBegin(1) != 0 || testGraph.degree(3) != 0) { failLog += "sparseNeighborGraph neighbors failed\n"; }
+	
+	//Stored edges, the diagonal and absent edges
+	//	RET: double
+	if(!filtrationEqual(testGraph(2,1), 0.7) || !filtrationEqual(testGraph(0,1), 0.5)) { failLog += "sparseNeighborGraph lookup failed\n"; }
+	if(testGraph(3,3) != 0 || !std::isinf(testGraph(0,2)) || !std::isinf(testGraph(3,0))) { failLog += "sparseNeighborGraph missing edge failed\n"; }
+	
+	//Tree insertion walks only the stored neighbors: triangle 0 1 2 and the edge 2 3
+	//	RET: int (4 vertices, 4 edges, 1 triangle)
+	std::map<std::string, std::string> config = {{"epsilon","1.0"},{"dimensions","2"}};
+	for(std::string type : {"simplexTree", "indSimplexTree"}){
+		std::vector<std::vector<std::pair<unsigned, double>>> triangle = {
+			{{1, 0.5}, {2, 0.5}},
+			{{0, 0.5}, {2, 0.5}},
+			{{0, 0.5}, {1, 0.5}, {3, 0.6}},
+			{{2, 0.6}}
+		};
+		simplexBase base;
+		base.maxEpsilon = 1.0;
+		base.maxDimension = 2;
+		simplexBase* testComplex = base.newSimplex(type, config);
+		testComplex->setNeighborGraph(sparseNeighborGraph(triangle));
+		std::vector<double> placeholder = {0};
+		for(unsigned i = 0; i < 4; i++)
+			testComplex->insert(placeholder);
+		if(testComplex->simplexCount() != 9) { failLog += type + " sparse insertion failed\n"; }
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: sparseNeighborGraph Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: sparseNeighborGraph Test Functions---------------------------\n";
+	}
+	
+	return;
+}
+
+// TEST nodeArena Functions
+void t_node_arena_functions(std::string &log){
+	std::string failLog = "";
+	nodeArena<simplexTree::treeNode, 2> testArena;
+	
+	//Allocate past the first slab (4 nodes), nodes start unlinked
+	//	RET: unsigned
+	std::vector<unsigned> ids;
+	for(unsigned i = 0; i < 6; i++){
+		ids.push_back(testArena.allocate());
+		testArena[ids.back()].index = 10 + i;
+	}
+	if(testArena.size() != 6 || ids[5] != 5 || testArena[5].index != 15 || testArena[4].child != nullNode) { failLog += "nodeArena allocate failed\n"; }
+	
+	//Released nodes are reused (and reset) before the arena grows
+	//	RET: void
+	testArena.release(ids[2]);
+	if(testArena.allocate() != ids[2] || testArena[ids[2]].index != 0 || testArena.size() != 6) { failLog += "nodeArena release failed\n"; }
+	
+	//Reset drops every node but keeps the slabs
+	//	RET: void
+	size_t reserved = testArena.reserved();
+	testArena.reset();
+	if(testArena.size() != 0 || testArena.allocate() != 0 || testArena.reserved() != reserved) { failLog += "nodeArena reset failed\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: nodeArena Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: nodeArena Test Functions---------------------------\n";
+	}
+	
+	return;
+}
+
+void t_small_simplex_functions(std::string &log){
+	std::string failLog = "";
+	
+	//Vertices are kept sorted and unique
+	//	RET: std::pair<iterator, bool>
+	smallSimplex testSimplex = {4, 1, 3};
+	if(!testSimplex.insert(2).second || testSimplex.insert(3).second || testSimplex.size() != 4 || *testSimplex.begin() != 1 || *testSimplex.rbegin() != 4) { failLog += "smallSimplex insert failed\n"; }
+	
+	//Faces drop the k-th vertex, cofaces add one
+	//	RET: smallSimplex
+	smallSimplex face = {1, 2, 4};
+	smallSimplex coface = {0, 1, 2, 3, 4};
+	if(testSimplex.face(2) != face || testSimplex.coface(0) != coface || !coface.includes(testSimplex) || testSimplex.includes(coface)) { failLog += "smallSimplex face/coface failed\n"; }
+	
+	//Erase, find and ordering match std::set
+	//	RET: size_type
+	std::set<unsigned> refSet = {1, 2, 4};
+	smallSimplex erased = testSimplex;
+	erased.erase(3);
+	if(erased != face || erased.find(3) != erased.end() || erased.count(4) != 1 || !(testSimplex < face) || !std::equal(erased.begin(), erased.end(), refSet.begin())) { failLog += "smallSimplex erase/find failed\n"; }
+	
+	//Inserting past capacity throws
+	//	RET: std::length_error
+	bool threw = false;
+	smallSimplex full;
+	try{ for(unsigned i = 0; i <= smallSimplex::capacity; i++) full.insert(i); }
+	catch(const std::length_error&){ threw = true; }
+	if(!threw || full.size() != smallSimplex::capacity) { failLog += "smallSimplex capacity failed\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: smallSimplex Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: smallSimplex Test Functions---------------------------\n";
+	}
+	
+	return;
+}
+
+void t_simplex_hash_functions(std::string &log){
+	std::string failLog = "";
+	
+	//Combinatorial number system keys are the colex rank of the simplex
+	//	RET: unsigned long long
+	binomialTable binomials(10, 3);
+	smallSimplex a = {0, 1, 2}, b = {0, 1, 3}, c = {7, 8, 9};
+	if(binomials(5, 2) != 10 || binomials.key(a) != 0 || binomials.key(b) != 1 || binomials.key(c) != 119 || !binomials.fits(10, 3)) { failLog += "binomialTable key failed\n"; }
+	
+	//Insert, probe and erase keyed entries through table growth
+	//	RET: const entry*
+	simplexHash index;
+	for(unsigned i = 0; i < 100; i++)
+		index.insert(i * 7, i / 10.0, i);
+	bool dup = index.insert(14, 0, 0);
+	index.erase(21);
+	auto hit = index.find(14);
+	if(dup || index.size() != 99 || hit == nullptr || hit->position != 2 || index.position(21) != noSimplex || index.position(693) != 99) { failLog += "simplexHash insert/find failed\n"; }
+	
+	//Face rows of a boundary column, faces missing from the rows are noSimplex
+	//	RET: std::vector<unsigned>
+	std::vector<std::pair<smallSimplex, double>> rows = {{{0,1}, 0.1}, {{1,2}, 0.2}, {{0,2}, 0.3}};
+	std::vector<std::pair<smallSimplex, double>> cols = {{{0,1,2}, 0.3}, {{1,2,3}, 0.4}};
+	std::vector<unsigned> faceRows = {1, 2, 0, noSimplex, noSimplex, 1};
+	if(boundaryRows(rows, cols) != faceRows) { failLog += "boundaryRows failed\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: simplexHash Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: simplexHash Test Functions---------------------------\n";
+	}
+	
+	return;
+}
+
+void t_union_find_functions(std::string &log){
+	std::string failLog = "";
+	
+	//Joins report the birth of the younger component (elder rule)
+	//	RET: bool
+	unionFind sets(std::vector<double>{0.0, 0.5, 0.2, 0.0});
+	double died = -1;
+	if(!sets.join(1, 2, died) || died != 0.5 || sets.birth(1) != 0.2) { failLog += "unionFind elder rule failed\n"; }
+	if(!sets.join(2, 0, died) || died != 0.2 || sets.join(0, 1, died) || sets.find(0) != sets.find(1) || sets.count() != 2) { failLog += "unionFind join/find failed\n"; }
+	
+	//Merging edges of a weight sorted edge list (the minimum spanning forest)
+	//	RET: std::vector<zeroPair>
+	std::vector<std::pair<smallSimplex, double>> vertices = {{{0}, 0}, {{1}, 0}, {{2}, 0}, {{3}, 0}};
+	std::vector<std::pair<smallSimplex, double>> edges = {{{0,1}, 0.1}, {{1,2}, 0.2}, {{0,2}, 0.3}, {{2,3}, 0.4}, {{0,3}, 0.5}};
+	auto pairs = zeroPersistence(vertices, edges);
+	if(pairs.size() != 3 || pairs[0].edge != 0 || pairs[1].edge != 1 || pairs[2].edge != 3 || pairs[2].death != 0.4) { failLog += "zeroPersistence failed\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: unionFind Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: unionFind Test Functions---------------------------\n";
+	}
+	
+	return;
+}
+
+void t_bit_matrix_functions(std::string &log){
+	std::string failLog = "";
+	
+	//Bit access across word and block boundaries
+	//	RET: bool / unsigned
+	bitMatrix m(3, 300);
+	m.set(0, 0); m.set(0, 63); m.set(0, 64); m.set(0, 299);
+	if(!m.get(0, 63) || !m.get(0, 64) || m.get(0, 65) || m.count(0) != 4) { failLog += "bitMatrix get/set/count failed\n"; }
+	if(m.firstSet(0) != 0 || m.firstSet(0, 1) != 63 || m.firstSet(0, 65) != 299 || m.lastSet(0) != 299 || m.firstSet(1) != 300 || !m.rowEmpty(1)) { failLog += "bitMatrix firstSet/lastSet failed\n"; }
+	m.set(1, 64); m.set(1, 200);
+	m.addRow(0, 1);
+	if(m.get(0, 64) || !m.get(0, 200) || m.count(0) != 4) { failLog += "bitMatrix addRow failed\n"; }
+	
+	//Elimination pivots match the unpacked (one word per entry) reduction
+	//	RET: pivot rows
+	srand(7);
+	unsigned rows = 60, cols = 150;
+	std::vector<std::vector<unsigned>> dense(rows, std::vector<unsigned>(cols, 0));
+	bitMatrix packed(rows, cols);
+	for(unsigned r = 0; r < rows; r++)
+		for(unsigned c = 0; c < cols; c++)
+			if(rand() % 25 == 0){ dense[r][c] = 1; packed.set(r, c); }
+	
+	std::vector<unsigned> densePivots, packedPivots;
+	for(unsigned i = 0; i < cols; i++){
+		for(unsigned j = 0; j < rows; j++){
+			if(dense[j][i] == 1){
+				densePivots.push_back(j);
+				std::vector<unsigned> temp = dense[j];
+				for(; j < rows; j++)
+					if(dense[j][i] == 1)
+						for(unsigned d = 0; d < cols; d++)
+							dense[j][d] ^= temp[d];
+			}
+		}
+	}
+	packed.eliminate([&](unsigned, unsigned pivot){ packedPivots.push_back(pivot); });
+	if(densePivots != packedPivots) { failLog += "bitMatrix eliminate failed\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: bitMatrix Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: bitMatrix Test Functions---------------------------\n";
+	}
+	
+	return;
+}
+
+void t_prime_field_functions(std::string &log){
+	std::string failLog = "";
+	
+	//Field arithmetic and precomputed inverses
+	//	RET: bool / unsigned short
+	if(!primeField::isPrime(2) || !primeField::isPrime(65521) || primeField::isPrime(1) || primeField::isPrime(91)) { failLog += "primeField isPrime failed\n"; }
+	for(unsigned p : {2u, 3u, 7u, 65521u}){
+		primeField field(p);
+		for(unsigned a = 1; a < p; a += 1 + p / 100)
+			if(field.mul(a, field.inverse(a)) != 1) { failLog += "primeField inverse failed for p = " + std::to_string(p) + "\n"; break; }
+	}
+	primeField z5(5);
+	if(z5.fromInt(-1) != 4 || z5.neg(0) != 0 || z5.add(3, 4) != 2) { failLog += "primeField arithmetic failed\n"; }
+	
+	//Scaled column addition drops cancelled entries
+	//	RET: void
+	std::vector<fieldEntry> a = {{1, 1}, {3, 2}}, b = {{0, 1}, {3, 4}}, scratch;
+	z5.addScaled(a, 2, b, scratch);
+	if(a.size() != 2 || a[0].row != 0 || a[0].coeff != 2 || a[1].row != 1 || a[1].coeff != 1) { failLog += "primeField addScaled failed\n"; }
+	
+	//Torsion: the 6 vertex real projective plane has rank 9 triangle boundaries over Z2, 10 over Z3
+	//	RET: reducedBoundary
+	std::vector<std::vector<std::pair<smallSimplex, double>>> rp2(3);
+	for(unsigned v = 0; v < 6; v++)
+		rp2[0].push_back({{v}, 0});
+	for(unsigned u = 0; u < 6; u++)
+		for(unsigned v = u + 1; v < 6; v++)
+			rp2[1].push_back({{u, v}, 0});
+	for(smallSimplex t : {smallSimplex{0,1,3}, smallSimplex{0,1,5}, smallSimplex{0,2,4}, smallSimplex{0,2,5}, smallSimplex{0,3,4}, smallSimplex{1,2,3}, smallSimplex{1,2,4}, smallSimplex{1,4,5}, smallSimplex{2,3,5}, smallSimplex{3,4,5}})
+		rp2[2].push_back({t, 0});
+	
+	for(unsigned p : {2u, 3u}){
+		auto reduced = twistReduce(rp2, 2, 1, false, primeField(p));
+		unsigned rank = 0;
+		for(auto l : reduced.low[2])
+			rank += (l != noSimplex);
+		if(rank != (p == 2 ? 9u : 10u)) { failLog += "twistReduce rank over Z/" + std::to_string(p) + " failed\n"; }
+	}
+	
+	//The pairs above the edges follow the field as well
+	//	RET: std::map<unsigned, unsigned>
+	for(unsigned p : {2u, 3u}){
+		unsigned triangles = 0;
+		for(auto& pair : simplexPairs(rp2, 2, "vector", 1, true, primeField(p)))
+			triangles += (pair.first >= rp2[0].size() + rp2[1].size());
+		if(triangles != (p == 2 ? 9u : 10u)) { failLog += "simplexPairs over Z/" + std::to_string(p) + " failed\n"; }
+	}
+	
+	//Chunked (threaded) reduction over Z/p gives the sequential lows
+	//	RET: std::vector<unsigned>
+	srand(41);
+	std::vector<std::vector<fieldEntry>> columns(3000);
+	for(unsigned j = 0; j < columns.size(); j++){
+		std::set<unsigned> rows;
+		for(unsigned k = 0; k < 3; k++)
+			rows.insert(rand() % (j / 2 + 3));
+		for(auto row : rows)
+			columns[j].push_back(fieldEntry{row, (unsigned short)(1 + rand() % 6)});
+	}
+	auto chunked = columns;
+	unsigned long long additions = 0;
+	primeField z7(7);
+	if(reduceColumns(columns, 1503, {}, additions, z7, 1) != reduceColumns(chunked, 1503, {}, additions, z7, 4)) { failLog += "reduceColumns over Z/7 threaded lows differ\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: primeField Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: primeField Test Functions---------------------------\n";
+	}
+	
+	return;
+}
+
 int main (int, char**){
 	std::string log;
 	t_simp_functions(log);
+	t_condensed_matrix_functions(log);
+	t_sparse_graph_functions(log);
+	t_node_arena_functions(log);
+	t_small_simplex_functions(log);
+	t_simplex_hash_functions(log);
+	t_union_find_functions(log);
+	t_bit_matrix_functions(log);
+	t_prime_field_functions(log);
 	
 	for(std::string type : {"simplexArrayList","simplexTree","indSimplexTree"}){
 		try{t_simp_empty_functions(log, type);}
@@ -1,7 +1,86 @@
 #include <iostream>
 #include <vector>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
 #include "basePipe.hpp"
 #include "pipePacket.hpp"
+#include "utils.hpp"
+#include "filtrationValue.hpp"
+#include "distanceMetrics.hpp"
+#include "pivotColumn.hpp"
+#include "twistReduction.hpp"
+#include "edgeCollapse.hpp"
+#include "simplexCollapse.hpp"
+#include "simplexCoreduction.hpp"
+
+// 12 points evenly spaced on the unit circle: one H1 class, born when adjacent points
+//		connect (2 sin(pi/12)) and filled when points 4 apart connect (sqrt(3))
+std::vector<std::vector<double>> t_circle_points(){
+	std::vector<std::vector<double>> points;
+	for(unsigned i = 0; i < 12; i++)
+		points.push_back({std::cos(i * M_PI / 6), std::sin(i * M_PI / 6)});
+	return points;
+}
+
+// 40 random points in the unit cube, repeatable for a seed
+std::vector<std::vector<double>> t_random_points(unsigned seed){
+	srand(seed);
+	std::vector<std::vector<double>> points;
+	for(unsigned i = 0; i < 40; i++)
+		points.push_back({(double)(rand() % 1000) / 1000, (double)(rand() % 1000) / 1000, (double)(rand() % 1000) / 1000});
+	return points;
+}
+
+// Run the pipeline stages in order on the points; complexType (default simplexArrayList),
+//		epsilon and dimensions are read from config. A stage that fails to configure is
+//		added to failLog and ends the run.
+pipePacket runPipeline(const std::vector<std::vector<double>>& points, const std::map<std::string, std::string>& config, const std::vector<std::string>& pipeline, std::string& failLog){
+	auto value = [&](const std::string& key, const std::string& fallback){
+		auto it = config.find(key);
+		return it == config.end() ? fallback : it->second;
+	};
+	
+	std::string complexType = value("complexType", "simplexArrayList");
+	pipePacket pack(complexType, std::atof(value("epsilon", "5").c_str()), std::atoi(value("dimensions", "1").c_str()));
+	pack.originalData = points;
+	
+	basePipe *bp = new basePipe();
+	for(auto& type : pipeline){
+		basePipe *testPipe = bp->newPipe(type, complexType);
+		if(testPipe == 0 || !testPipe->configPipe(config)){ failLog += type + " config failed\n"; break; }
+		pack = testPipe->runPipe(pack);
+	}
+	return pack;
+}
+
+// Intervals {dim, birth, death} of positive persistence, sorted (collapses and coreductions may
+//		change zero length pairs). Pipes without a betti table (optPersistencePairs) are read
+//		from the output
+std::vector<std::vector<double>> positiveIntervals(const pipePacket& pack){
+	std::vector<std::vector<double>> ret;
+	for(auto& entry : pack.bettiTable)
+		if(entry.death > entry.birth)
+			ret.push_back({(double)entry.bettiDim, entry.birth, entry.death});
+	
+	if(pack.bettiTable.empty()){
+		std::stringstream bettis(pack.bettiOutput);
+		std::string line;
+		std::getline(bettis, line);
+		while(std::getline(bettis, line)){
+			std::vector<double> interval;
+			std::stringstream fields(line);
+			std::string field;
+			while(std::getline(fields, field, ','))
+				interval.push_back(std::atof(field.c_str()));
+			if(interval.size() == 3 && interval[2] > interval[1])
+				ret.push_back(interval);
+		}
+	}
+	
+	std::sort(ret.begin(), ret.end());
+	return ret;
+}
 
 // TEST basePipe Functions
 void t_pipe_functions(std::string &log){
@@ -69,15 +148,555 @@ void t_pipe_empty_functions(std::string &log, std::string type, std::string comp
 	return;
 }
 
+// TEST distMatrix threaded kernel against the direct distance
+void t_distmatrix_threads(std::string &log){
+	std::string failLog = "";
+	utils ut;
+	
+	//Deterministic point cloud spanning several tiles
+	std::vector<std::vector<double>> points;
+	for(unsigned i = 0; i < 150; i++){
+		std::vector<double> point;
+		for(unsigned k = 0; k < 5; k++)
+			point.push_back(std::sin(i * 1.7 + k * 0.3) * (k + 1));
+		points.push_back(point);
+	}
+	
+	std::vector<pipePacket> results;
+	for(std::string threads : {"1", "4"})
+		results.push_back(runPipeline(points, {{"epsilon","5.0"},{"dimensions","2"},{"threads",threads}}, {"distMatrix"}, failLog));
+	
+	auto &single = results[0].complex->distMatrix;
+	auto &multi = results[1].complex->distMatrix;
+	if(single.size() != points.size() || multi.size() != points.size()){ failLog += "distMatrix size mismatch\n"; }
+	else {
+		for(unsigned i = 0; i < points.size(); i++){
+			for(unsigned j = i + 1; j < points.size(); j++){
+				if(single(i,j) != multi(i,j)){ failLog += "distMatrix threaded result differs\n"; i = j = points.size(); break; }
+				if(!filtrationEqual(single(i,j), ut.vectors_distance(points[i], points[j]), 1e-9)){ failLog += "distMatrix distance incorrect\n"; i = j = points.size(); break; }
+			}
+		}
+	}
+	if(results[0].weights != results[1].weights){ failLog += "distMatrix threaded weights differ\n"; }
+	
+	//A cache directory that cannot be created only turns the cache off
+	auto uncached = runPipeline(points, {{"epsilon","5.0"},{"dimensions","2"},{"cacheDir","/dev/null/lhfCache"}}, {"distMatrix"}, failLog);
+	if(uncached.weights != results[0].weights){ failLog += "distMatrix with unusable cacheDir differs\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: distMatrix Thread Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: distMatrix Thread Test Functions---------------------------\n";
+	}
+	return;
+}
+
+// Scalar reference for each supported metric
+double t_reference_distance(const std::string &metric, const std::vector<double> &a, const std::vector<double> &b){
+	double sq = 0, l1 = 0, linf = 0, dot = 0, aa = 0, bb = 0;
+	for(unsigned k = 0; k < a.size(); k++){
+		sq += (a[k] - b[k]) * (a[k] - b[k]);
+		l1 += std::abs(a[k] - b[k]);
+		linf = std::max(linf, std::abs(a[k] - b[k]));
+		dot += a[k] * b[k];
+		aa += a[k] * a[k];
+		bb += b[k] * b[k];
+	}
+	if(metric == "sqeuclidean") return sq;
+	if(metric == "manhattan") return l1;
+	if(metric == "chebyshev") return linf;
+	if(metric == "cosine") return 1 - dot / std::sqrt(aa * bb);
+	return std::sqrt(sq);
+}
+
+// TEST distMatrix metrics for fixed (3D) and general (5D) kernels
+void t_distmatrix_metrics(std::string &log){
+	std::string failLog = "";
+	
+	for(unsigned dim : {3, 5}){
+		std::vector<std::vector<double>> points;
+		for(unsigned i = 0; i < 40; i++){
+			std::vector<double> point;
+			for(unsigned k = 0; k < dim; k++)
+				point.push_back(std::cos(i * 0.9 + k * 1.3) * (k + 2));
+			points.push_back(point);
+		}
+		
+		for(std::string metric : {"euclidean", "sqeuclidean", "manhattan", "chebyshev", "cosine"}){
+			auto result = runPipeline(points, {{"epsilon","5.0"},{"dimensions","2"},{"metric",metric}}, {"distMatrix"}, failLog);
+			auto &distMatrix = result.complex->distMatrix;
+			
+			bool match = distMatrix.size() == points.size();
+			for(unsigned i = 0; i < points.size() && match; i++)
+				for(unsigned j = i + 1; j < points.size() && match; j++)
+					match = filtrationEqual(distMatrix(i,j), t_reference_distance(metric, points[i], points[j]), 1e-9);
+			
+			if(!match){ failLog += "distMatrix " + metric + " (" + std::to_string(dim) + "D) incorrect\n"; }
+		}
+	}
+	
+	//Rows shorter than the point use the general kernel over the shared coordinates
+	std::vector<double> point = {0.5, -1.0, 2.0};
+	std::vector<std::vector<double>> cloud = {{1.0, 2.0, 3.0}, {-2.0, 0.5}, {4.0, 1.0, -1.0}};
+	for(std::string metric : {"euclidean", "sqeuclidean", "manhattan", "chebyshev", "cosine"}){
+		auto distances = metricDistances(metric, point, cloud);
+		for(unsigned i = 0; i < cloud.size(); i++)
+			if(!filtrationEqual(distances[i], t_reference_distance(metric, cloud[i], point), 1e-9)){ failLog += "metricDistances " + metric + " ragged cloud incorrect\n"; break; }
+	}
+	
+	//Unknown metrics are rejected at configuration
+	basePipe *bp = new basePipe();
+	basePipe *testPipe = bp->newPipe("distMatrix", "simplexArrayList");
+	std::map<std::string, std::string> testConfig = {{"epsilon","5.0"},{"metric","hamming"}};
+	if(testPipe->configPipe(testConfig)){ failLog += "distMatrix accepted unknown metric\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: distMatrix Metric Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: distMatrix Metric Test Functions---------------------------\n";
+	}
+	return;
+}
+
+// TEST implicitPersistence on a circle (one H1 class) for dense and sparse distances
+void t_implicit_persistence(std::string &log){
+	std::string failLog = "";
+	
+	auto points = t_circle_points();
+	double side = 2 * std::sin(M_PI / 12);		//Adjacent points connect, the cycle is born
+	double fill = std::sqrt(3.0);				//Points 4 apart connect, the cycle is filled
+	
+	std::vector<std::string> outputs;
+	for(std::string distances : {"distMatrix", "sparseNeighborhood"}){
+		auto pack = runPipeline(points, {{"epsilon","2.5"},{"dimensions","2"}}, {distances, "implicitPersistence"}, failLog);
+		outputs.push_back(pack.bettiOutput);
+		
+		unsigned h0 = 0, h1 = 0;
+		for(auto& entry : pack.bettiTable){
+			if(entry.bettiDim == 0) h0++;
+			else if(entry.bettiDim == 1){
+				h1++;
+				if(!filtrationEqual(entry.birth, side) || !filtrationEqual(entry.death, fill)){ failLog += distances + " H1 interval incorrect\n"; }
+				if(entry.boundaryPoints.size() < 2){ failLog += distances + " H1 boundary incorrect\n"; }
+			} else { failLog += distances + " dimension above H1 reported\n"; }
+		}
+		if(h0 != points.size()){ failLog += distances + " H0 count incorrect\n"; }
+		if(h1 != 1){ failLog += distances + " H1 count incorrect\n"; }
+	}
+	if(outputs[0] != outputs[1]){ failLog += "implicitPersistence dense and sparse differ\n"; }
+	
+	//Below the H1 death the barcode matches fastPersistence: a single essential H0 interval
+	//		(also with several components left) and no essential classes above H0
+	std::vector<std::pair<std::vector<std::vector<double>>, std::string>> inputs = {{points, "1.0"}, {points, "0.6"}, {t_random_points(29), "0.15"}};
+	for(auto& input : inputs){
+		auto& eps = input.second;
+		auto implicit = positiveIntervals(runPipeline(input.first, {{"epsilon",eps},{"dimensions","2"}}, {"distMatrix", "implicitPersistence"}, failLog));
+		auto fast = positiveIntervals(runPipeline(input.first, {{"epsilon",eps},{"dimensions","2"},{"twist","true"},{"complexType","simplexTree"}}, {"distMatrix", "neighGraph", "rips", "fastPersistence"}, failLog));
+		if(implicit != fast){ failLog += "implicitPersistence differs from fastPersistence at eps " + eps + "\n"; }
+		
+		unsigned essential = 0;
+		for(auto& interval : implicit)
+			if(interval[2] == std::atof(eps.c_str()))
+				essential += (interval[0] == 0) ? 1 : 2;
+		if(essential != 1){ failLog += "implicitPersistence essential classes incorrect at eps " + eps + "\n"; }
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: implicitPersistence Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: implicitPersistence Test Functions---------------------------\n";
+	}
+	return;
+}
+
+// TEST twist reduction: same pivots as the default reduction, correct intervals on a circle
+void t_twist_persistence(std::string &log){
+	std::string failLog = "";
+	
+	auto points = t_circle_points();
+	auto run = [&](std::string persistence, std::string twist){
+		return runPipeline(points, {{"epsilon","2.5"},{"dimensions","3"},{"twist",twist},{"complexType","simplexTree"}}, {"distMatrix", "neighGraph", "rips", persistence}, failLog);
+	};
+	
+	if(run("persistence", "true").bettiOutput != run("persistence", "false").bettiOutput){ failLog += "persistence twist output differs\n"; }
+	
+	//One H1 class, born by adjacent points and filled by points 4 apart
+	unsigned h1 = 0;
+	for(auto& entry : run("fastPersistence", "true").bettiTable){
+		if(entry.bettiDim == 1){
+			h1++;
+			if(!filtrationEqual(entry.birth, 2 * std::sin(M_PI / 12)) || !filtrationEqual(entry.death, std::sqrt(3.0))){ failLog += "fastPersistence twist H1 interval incorrect\n"; }
+		}
+	}
+	if(h1 != 1){ failLog += "fastPersistence twist H1 count incorrect\n"; }
+	
+	//Twist only adds clearing: same pairs as the default reduction, no more column additions
+	auto pack = run("fastPersistence", "false");
+	if(pack.bettiOutput != run("fastPersistence", "true").bettiOutput){ failLog += "fastPersistence twist output differs\n"; }
+	
+	auto chains = pack.complex->getAllEdges(2.5);
+	std::vector<bool> merged(chains[1].size(), false);
+	for(auto merge : zeroPersistence(chains[0], chains[1]))
+		merged[merge.edge] = true;
+	
+	unsigned long long unclearedAdditions = 0;
+	for(unsigned d = 2; d < chains.size(); d++)
+		unclearedAdditions += twistReduce(chains, d, d, false, "vector", 1, merged).additions;
+	if(twistReduce(chains, chains.size() - 1, 2, false, "vector", 1, merged).additions > unclearedAdditions){ failLog += "fastPersistence twist additions exceed the default\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: twist Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: twist Test Functions---------------------------\n";
+	}
+	return;
+}
+
+// TEST working column types: same reduced columns and barcodes for every representation
+void t_column_types(std::string &log){
+	std::string failLog = "";
+	
+	//Additions into each working column match the sorted vector merge
+	//	RET: sorted rows / pivot
+	std::vector<std::vector<unsigned>> columns = {{1, 5, 70, 4100}, {5, 9, 70}, {0, 1, 9, 4100, 9000}, {2, 5}};
+	for(std::string type : {"heap", "bit_tree", "full"}){
+		std::vector<unsigned> expected, result;
+		unsigned expectedPivot = 0, resultPivot = 0;
+		dispatchColumn("vector", [&](auto work){ work.init(10000); work.load(columns[0]); for(unsigned i = 1; i < columns.size(); i++) work.add(columns[i]); expectedPivot = work.pivot(); work.store(expected); return 0; });
+		dispatchColumn(type, [&](auto work){ work.init(10000); work.load(columns[0]); for(unsigned i = 1; i < columns.size(); i++) work.add(columns[i]); resultPivot = work.pivot(); work.store(result); return 0; });
+		if(result != expected || resultPivot != expectedPivot){ failLog += type + " column additions incorrect\n"; }
+	}
+	
+	auto points = t_circle_points();
+	auto run = [&](std::string columnType, std::string twist){
+		return runPipeline(points, {{"epsilon","2.5"},{"dimensions","3"},{"twist",twist},{"columnType",columnType},{"complexType","simplexTree"}}, {"distMatrix", "neighGraph", "rips", "fastPersistence"}, failLog).bettiOutput;
+	};
+	
+	for(std::string twist : {"false", "true"}){
+		std::string expected = run("vector", twist);
+		for(std::string type : {"heap", "bit_tree", "full"})
+			if(run(type, twist) != expected){ failLog += type + " (twist " + twist + ") output differs\n"; }
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: columnType Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: columnType Test Functions---------------------------\n";
+	}
+	return;
+}
+
+// TEST chunked reduction: threaded reduction pairs the same simplices as a single thread
+void t_chunk_reduction(std::string &log){
+	std::string failLog = "";
+	
+	auto points = t_circle_points();
+	auto run = [&](std::string persistence, std::string twist, std::string threads){
+		return runPipeline(points, {{"epsilon","2.5"},{"dimensions","3"},{"twist",twist},{"threads",threads},{"complexType","simplexTree"}}, {"distMatrix", "neighGraph", "rips", persistence}, failLog).bettiOutput;
+	};
+	
+	//495 tetrahedra, split into chunks of the top dimension
+	for(std::string twist : {"false", "true"}){
+		if(run("fastPersistence", twist, "4") != run("fastPersistence", twist, "1")){ failLog += "fastPersistence (twist " + twist + ") threaded output differs\n"; }
+	}
+	if(run("persistence", "true", "4") != run("persistence", "true", "1")){ failLog += "persistence threaded output differs\n"; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: chunk reduction Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: chunk reduction Test Functions---------------------------\n";
+	}
+	return;
+}
+
+void t_lockfree_persistence(std::string &log){
+	std::string failLog = "";
+	
+	auto points = t_circle_points();
+	auto run = [&](std::string persistence, std::string columnType, std::string threads){
+		return runPipeline(points, {{"epsilon","2.5"},{"dimensions","3"},{"twist","true"},{"columnType",columnType},{"threads",threads},{"complexType","simplexTree"}}, {"distMatrix", "neighGraph", "rips", persistence}, failLog).bettiOutput;
+	};
+	
+	//Pairs of the lock-free reduction match the sequential twist reduction for any thread count
+	std::string expected = run("fastPersistence", "vector", "1");
+	for(std::string columnType : {"vector", "heap", "bit_tree"}){
+		for(std::string threads : {"1", "4"}){
+			if(run("lockFreePersistence", columnType, threads) != expected){ failLog += "lockFreePersistence (" + columnType + ", " + threads + " threads) output differs\n"; }
+		}
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: lock-free persistence Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: lock-free persistence Test Functions---------------------------\n";
+	}
+	return;
+}
+
+void t_coeff_persistence(std::string &log){
+	std::string failLog = "";
+	
+	auto points = t_circle_points();
+	auto run = [&](std::string coeff){
+		return runPipeline(points, {{"epsilon","2.5"},{"dimensions","3"},{"twist","true"},{"coeff",coeff},{"complexType","simplexTree"}}, {"distMatrix", "neighGraph", "rips", "fastPersistence"}, failLog).bettiOutput;
+	};
+	
+	//The circle has no torsion: every field gives the Z2 intervals; non-primes fall back to Z2
+	std::string expected = run("2");
+	for(std::string coeff : {"3", "5", "65521", "4"}){
+		if(run(coeff) != expected){ failLog += "fastPersistence (coeff " + coeff + ") output differs\n"; }
+	}
+	
+	//Z/p through the chunked reduction matches the sequential one
+	auto cloud = t_random_points(31);
+	auto runCloud = [&](std::string coeff, std::string threads){
+		return runPipeline(cloud, {{"epsilon","0.45"},{"dimensions","3"},{"twist","true"},{"coeff",coeff},{"threads",threads},{"complexType","simplexTree"}}, {"distMatrix", "neighGraph", "rips", "fastPersistence"}, failLog).bettiOutput;
+	};
+	if(runCloud("3", "4") != runCloud("3", "1")){ failLog += "fastPersistence (coeff 3) threaded output differs\n"; }
+	if(runCloud("3", "4") != runCloud("2", "1")){ failLog += "fastPersistence (coeff 3) cloud output differs from Z2\n"; }
+	
+	//The twistReduce path of persistence (twist, or indSimplexTree) reduces over Z/p as well
+	for(std::string complexType : {"simplexTree", "indSimplexTree"}){
+		std::string twist = (complexType == "simplexTree") ? "true" : "false";
+		auto runPairs = [&](std::string coeff){
+			return runPipeline(points, {{"epsilon","2.5"},{"dimensions","2"},{"twist",twist},{"coeff",coeff},{"threads","2"},{"complexType",complexType}}, {"distMatrix", "neighGraph", "rips", "persistence"}, failLog).bettiOutput;
+		};
+		if(runPairs("3") != runPairs("2")){ failLog += complexType + " persistence (coeff 3) output differs\n"; }
+	}
+	
+	//The Z2 only stages refuse other coefficients instead of silently using Z2
+	basePipe *bp = new basePipe();
+	for(std::string type : {"persistence", "boundary", "implicitPersistence", "lockFreePersistence"}){
+		basePipe *testPipe = bp->newPipe(type, "simplexTree");
+		if(testPipe->configPipe({{"epsilon","2.5"},{"dimensions","1"},{"twist","false"},{"coeff","3"}})){ failLog += type + " accepted coeff 3\n"; }
+		if(!testPipe->configPipe({{"epsilon","2.5"},{"dimensions","1"},{"twist","false"},{"coeff","2"}})){ failLog += type + " rejected coeff 2\n"; }
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: coeff Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: coeff Test Functions---------------------------\n";
+	}
+	return;
+}
+
+void t_min_persistence(std::string &log){
+	std::string failLog = "";
+	
+	auto points = t_circle_points();
+	
+	//Only the cycle (~1.21) and the essential component (2.5) outlive 1.0; the short H0
+	//		intervals (~0.52) are dropped by every engine
+	for(std::vector<std::string> pipeline : {std::vector<std::string>{"distMatrix", "neighGraph", "rips", "fastPersistence"}, std::vector<std::string>{"distMatrix", "neighGraph", "rips", "lockFreePersistence"}, std::vector<std::string>{"distMatrix", "implicitPersistence"}}){
+		auto pack = runPipeline(points, {{"epsilon","2.5"},{"dimensions","2"},{"twist","true"},{"minPersistence","1.0"},{"complexType","simplexTree"}}, pipeline, failLog);
+		
+		unsigned h0 = 0, h1 = 0;
+		for(auto& entry : pack.bettiTable){
+			if(entry.death - entry.birth < 1.0){ failLog += pipeline.back() + " short interval reported\n"; }
+			if(entry.bettiDim == 0) h0++;
+			else if(entry.bettiDim == 1) h1++;
+		}
+		if(h0 != 1 || h1 != 1){ failLog += pipeline.back() + " interval count incorrect\n"; }
+		if(std::count(pack.bettiOutput.begin(), pack.bettiOutput.end(), '\n') != 2){ failLog += pipeline.back() + " output incorrect\n"; }
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: minPersistence Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: minPersistence Test Functions---------------------------\n";
+	}
+	return;
+}
+
+void t_flag_expansion(std::string &log){
+	std::string failLog = "";
+	
+	auto points = t_random_points(11);
+	
+	//Simplices (sorted, with weights) of each dimension after the rips expansion
+	//	(unsorted keeps the complex's filtration order)
+	auto expand = [&](std::string complexType, std::string threads, std::string sparse = "false", bool sorted = true){
+		auto pack = runPipeline(points, {{"epsilon","0.6"},{"dimensions","4"},{"threads",threads},{"complexType",complexType},{"sparse",sparse}}, {"distMatrix", "neighGraph", "rips"}, failLog);
+		
+		std::vector<std::vector<std::pair<std::vector<unsigned>, double>>> ret;
+		for(auto& dim : pack.complex->getAllEdges(0.6)){
+			ret.emplace_back();
+			for(auto& simplex : dim)
+				ret.back().push_back(std::make_pair(std::vector<unsigned>(simplex.first.begin(), simplex.first.end()), simplex.second));
+			if(sorted)
+				std::sort(ret.back().begin(), ret.back().end());
+		}
+		return ret;
+	};
+	
+	//The array list's clique expansion builds the same flag complex as the simplex tree, once each
+	auto arrayList = expand("simplexArrayList", "1");
+	auto tree = expand("simplexTree", "1");
+	if(arrayList.size() < 4){ failLog += "simplexArrayList expansion too shallow\n"; }
+	if(arrayList != tree){ failLog += "simplexArrayList and simplexTree expansions differ\n"; }
+	if(expand("simplexArrayList", "4") != arrayList){ failLog += "simplexArrayList threaded expansion differs\n"; }
+	
+	//The trees built from the parallel lower stars match the point by point insertion, in order
+	for(std::string complexType : {"simplexTree", "indSimplexTree"}){
+		for(std::string sparse : {"false", "true"}){
+			auto sequential = expand(complexType, "1", sparse, false);
+			if(sequential.size() < 4){ failLog += complexType + " expansion too shallow\n"; }
+			if(expand(complexType, "4", sparse, false) != sequential){ failLog += complexType + " threaded insertion differs (sparse " + sparse + ")\n"; }
+		}
+	}
+	for(auto& dim : arrayList)
+		if(std::adjacent_find(dim.begin(), dim.end(), [](const std::pair<std::vector<unsigned>, double>& a, const std::pair<std::vector<unsigned>, double>& b){ return a.first == b.first; }) != dim.end()){ failLog += "simplexArrayList duplicate simplex\n"; break; }
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: flag expansion Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: flag expansion Test Functions---------------------------\n";
+	}
+	return;
+}
+
+void t_edge_collapse(std::string &log){
+	std::string failLog = "";
+	
+	//The last edge of a triangle is dominated by the opposite vertex, a 4-cycle has no dominated edge
+	if(collapseEdges(3, {{0, 1, 1}, {1, 2, 2}, {0, 2, 3}}).size() != 2){ failLog += "collapseEdges triangle failed\n"; }
+	if(collapseEdges(4, {{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {0, 3, 1}}).size() != 4){ failLog += "collapseEdges 4-cycle failed\n"; }
+	
+	auto points = t_random_points(13);
+	
+	//Intervals of positive persistence and the edge count
+	auto barcode = [&](std::string complexType, bool collapse, size_t& edges){
+		std::vector<std::string> pipeline = {"distMatrix", "neighGraph", "rips", "fastPersistence"};
+		if(collapse)
+			pipeline.insert(pipeline.begin() + 1, "edgeCollapse");
+		
+		auto pack = runPipeline(points, {{"epsilon","0.7"},{"dimensions","3"},{"twist","true"},{"complexType",complexType}}, pipeline, failLog);
+		edges = pack.complex->getAllEdges(0.7)[1].size();
+		return positiveIntervals(pack);
+	};
+	
+	//Collapsing the 1-skeleton before the expansion leaves the persistence unchanged
+	for(std::string complexType : {"simplexArrayList", "simplexTree"}){
+		size_t full, collapsed;
+		auto expected = barcode(complexType, false, full);
+		if(barcode(complexType, true, collapsed) != expected){ failLog += complexType + " collapsed barcode differs\n"; }
+		if(collapsed >= full){ failLog += complexType + " no edges collapsed\n"; }
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: edge collapse Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: edge collapse Test Functions---------------------------\n";
+	}
+	return;
+}
+
+void t_complex_collapse(std::string &log){
+	std::string failLog = "";
+	
+	//The longest edge of a filled triangle is free and enters with the triangle
+	std::vector<std::vector<std::pair<smallSimplex, double>>> triangle = {{{{0}, 0}, {{1}, 0}, {{2}, 0}}, {{{0, 1}, 1}, {{1, 2}, 2}, {{0, 2}, 3}}, {{{0, 1, 2}, 3}}};
+	auto removed = collapseComplex(triangle);
+	if(removed[2][0] != 1 || removed[1] != std::vector<char>{0, 0, 1}){ failLog += "collapseComplex triangle failed\n"; }
+	
+	auto points = t_random_points(17);
+	
+	//Intervals of positive persistence and the simplex count of the reduced complex
+	auto barcode = [&](std::string complexType, std::string collapse, int& simplices){
+		auto pack = runPipeline(points, {{"epsilon","0.4"},{"dimensions","2"},{"twist","true"},{"collapse",collapse},{"complexType",complexType}}, {"distMatrix", "neighGraph", "rips", "fastPersistence"}, failLog);
+		simplices = pack.complex->simplexCount();
+		return positiveIntervals(pack);
+	};
+	
+	//Collapsing the complex removes simplices and leaves the persistence unchanged
+	for(std::string complexType : {"simplexArrayList", "simplexTree", "indSimplexTree"}){
+		int full, collapsed;
+		auto expected = barcode(complexType, "false", full);
+		if(barcode(complexType, "true", collapsed) != expected){ failLog += complexType + " collapsed barcode differs\n"; }
+		if(collapsed >= full){ failLog += complexType + " no simplices collapsed\n"; }
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: complex collapse Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: complex collapse Test Functions---------------------------\n";
+	}
+	return;
+}
+
+void t_complex_coreduction(std::string &log){
+	std::string failLog = "";
+	
+	//Without the merge edges (0 1, 0 2) the longest edge is the only face of the triangle
+	std::vector<std::vector<std::pair<smallSimplex, double>>> triangle = {{{{0}, 0}, {{1}, 0}, {{2}, 0}}, {{{0, 1}, 1}, {{0, 2}, 2}, {{1, 2}, 3}}, {{{0, 1, 2}, 3}}};
+	auto removed = coreduceComplex(triangle);
+	if(removed[2][0] != 1 || removed[1] != std::vector<char>{0, 0, 1} || removed[0] != std::vector<char>{0, 0, 0}){ failLog += "coreduceComplex triangle failed\n"; }
+	
+	auto points = t_random_points(23);
+	
+	//Intervals of positive persistence and the size of the graph the persistence stage reduces
+	auto barcode = [&](std::string twist, std::string collapse, unsigned& simplices){
+		auto pack = runPipeline(points, {{"epsilon","0.45"},{"dimensions","2"},{"twist",twist},{"collapse",collapse},{"complexType","indSimplexTree"}}, {"distMatrix", "neighGraph", "rips", "persistence"}, failLog);
+		simplices = 0;
+		for(auto& entries : pack.complex->getIndexEdges(0.45))
+			simplices += entries.size();
+		return positiveIntervals(pack);
+	};
+	
+	//Coreduction pairs leave the graph of the persistence stage and the persistence is unchanged,
+	//		with or without twist
+	unsigned full, coreduced;
+	auto expected = barcode("true", "false", full);
+	for(std::string twist : {"true", "false"}){
+		if(barcode(twist, "false", full) != expected){ failLog += "indSimplexTree barcode differs (twist " + twist + ")\n"; }
+		if(barcode(twist, "true", coreduced) != expected){ failLog += "indSimplexTree coreduced barcode differs (twist " + twist + ")\n"; }
+		if(coreduced >= full){ failLog += "indSimplexTree no simplices coreduced (twist " + twist + ")\n"; }
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: complex coreduction Test Functions---------------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: complex coreduction Test Functions---------------------------\n";
+	}
+	return;
+}
+
 int main (int, char**){
 	std::string log;
 	t_pipe_functions(log);
 	
 	
-	for(std::string type : {"distMatrix","neighGraph","rips","upscale","boundary","persistence","slidingwindow","fastPersistence"}){ 
+	for(std::string type : {"distMatrix","neighGraph","rips","upscale","boundary","persistence","slidingwindow","fastPersistence","implicitPersistence"}){ 
 		try{t_pipe_empty_functions(log, type, "simplexArrayList");}
 		catch(const std::exception){log += "FAILED: " + type + " Empty Test Functions---------------------------\n";}			
 	}
 	
+	t_distmatrix_threads(log);
+	t_distmatrix_metrics(log);
+	t_implicit_persistence(log);
+	t_twist_persistence(log);
+	t_column_types(log);
+	t_chunk_reduction(log);
+	t_lockfree_persistence(log);
+	t_coeff_persistence(log);
+	t_min_persistence(log);
+	t_flag_expansion(log);
+	t_edge_collapse(log);
+	t_complex_collapse(log);
+	t_complex_coreduction(log);
+	
 	std::cout << std::endl << std::endl << log << std::endl;
 }
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include "readInput.hpp"
+#include "filtrationValue.hpp"
 
 // TEST read Functions
 void t_read_functions(std::string &log){
@@ -34,9 +35,50 @@ void t_read_functions(std::string &log){
 	return;
 }
 
+// TEST read precomputed distances (distmatrix / edgelist input formats)
+void t_read_distances(std::string &log){
+	auto *rs = new readInput();
+	std::string failLog = "";
+	
+	//Missing files load as empty
+	if(!rs->readDistMatrix("test").empty()){ failLog += "readInput readDistMatrix missing file failed\n"; }
+	if(!rs->readEdgeList("test").empty()){ failLog += "readInput readEdgeList missing file failed\n"; }
+	
+	//Upper triangular matrix (20 points), lookups are symmetric
+	// RET: condensedDistMatrix
+	auto distMatrix = rs->readDistMatrix(std::string(TEST_DATA_DIR) + "50_Points_DistMatrix.csv");
+	if(distMatrix.size() != 20){ failLog += "readInput readDistMatrix size failed\n"; }
+	else if(!filtrationEqual(distMatrix(0,1), 6.72682) || !filtrationEqual(distMatrix(1,0), 6.72682) || !filtrationEqual(distMatrix(1,2), 3.96201)){ failLog += "readInput readDistMatrix values failed\n"; }
+	
+	//Weighted edge list, vertex lines declare the points and edges are stored both ways
+	// RET: sparseNeighborGraph
+	auto graph = rs->readEdgeList(std::string(TEST_DATA_DIR) + "50_Points_NeighGraph.csv");
+	if(graph.size() != 20){ failLog += "readInput readEdgeList size failed\n"; }
+	else if(!filtrationEqual(graph(9,14), 0.750674) || !filtrationEqual(graph(14,9), 0.750674) || !filtrationEqual(graph(0,14), 0.812252)){ failLog += "readInput readEdgeList values failed\n"; }
+	
+	//Every stored edge must agree with the full distance matrix
+	if(graph.size() == distMatrix.size()){
+		for(unsigned i = 0; i < graph.size(); i++){
+			auto w = graph.weightsBegin(i);
+			for(auto j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++, w++)
+				if(!filtrationEqual(*w, distMatrix(i,*j))){ failLog += "readInput readEdgeList mismatch (" + std::to_string(i) + "," + std::to_string(*j) + ")\n"; }
+		}
+	}
+	
+	//Output log status to calling function
+	if(failLog.size() > 0){
+		log += "FAILED: Read Distance Functions-----------------------\n" + failLog;	
+	} else {
+		 log += "PASSED: Read Distance Functions-----------------------\n";
+	}
+	
+	return;
+}
+
 int main (int, char**){
 	std::string log;
 	t_read_functions(log);
+	t_read_distances(log);
 	
 	std::cout << std::endl << log << std::endl;
 }